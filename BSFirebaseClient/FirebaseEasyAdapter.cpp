@@ -11,13 +11,8 @@ using namespace FBEasy;
 
 //*********************************************************************************************************//
 /* client thread function */
-void FirebaseDBEasyAdapter::clientThreadProcess()
+void FirebaseDBEasyAdapter::clientThreadProcess(std::stop_token stopToken)
 {
-	//set client thread work flag
-	unique_lock<mutex> lock_clientThreadWork(clientThreadWork.sMutex);
-	clientThreadWork.sValue = true;
-	lock_clientThreadWork.unlock();
-
 	//init google firebase >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 	//app init
 	writeToLog("Start initialize Firebase App...");
@@ -42,7 +37,6 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 	catch (...)
 	{
 		//thread shutdown
-		clientThreadClose();
 		writeToLog("Failed to initialize Firebase App");
 		writeToLog("Client thread closed");
 		return;
@@ -75,10 +69,9 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 	};
 	::firebase::ModuleInitializer initializer;
 	initializer.Initialize(app.get(), initialize_targets, initializers, sizeof(initializers) / sizeof(initializers[0]));
-	if (!waitForCompletion(initializer.InitializeLastResult(), "Initialize Firebase Auth and Firebase Database process"))
+	if (!waitForCompletion(stopToken, initializer.InitializeLastResult(), "Initialize Firebase Auth and Firebase Database process"))
 	{
 		//thread shutdown
-		clientThreadClose();
 		writeToLog("Client thread closed");
 		return;
 	}
@@ -90,7 +83,6 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 		writeToLog("Failed to initialize Firebase libraries: " + errMsg);
 		waitAndEvents(2000);
 		//thread shutdown
-		clientThreadClose();
 		writeToLog("Client thread closed");
 		return;
 	}
@@ -102,10 +94,9 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 	writeToLog("Auth: sign in...");
 	firebase::Future<firebase::auth::User*> signInFuture =
 		auth->SignInWithEmailAndPassword(clientEMail.c_str(), clientPassword.c_str());
-	if (!waitForCompletion(signInFuture, "Sign in process"))
+	if (!waitForCompletion(stopToken, signInFuture, "Sign in process"))
 	{
 		//thread shutdown
-		clientThreadClose();
 		writeToLog("Client thread closed");
 		return;
 	}
@@ -115,10 +106,9 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 		writeToLog("Auth: client with specified email not found");
 		writeToLog("Auth: try register new client...");
 		signInFuture = auth->CreateUserWithEmailAndPassword(clientEMail.c_str(), clientPassword.c_str());
-		if (!waitForCompletion(signInFuture, "Register client and sign in process"))
+		if (!waitForCompletion(stopToken, signInFuture, "Register client and sign in process"))
 		{
 			//thread shutdown
-			clientThreadClose();
 			writeToLog("Client thread closed");
 			return;
 		}
@@ -132,7 +122,6 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 		writeToLog("ERROR: Could not sign in. Error " + std::to_string(signInFuture.error()) + ": " + signInFuture.error_message());
 		writeToLog("Ensure your application has the email sign-in provider enabled in Firebase Console.");
 		//thread shutdown
-		clientThreadClose();
 		writeToLog("Client thread closed");
 		return;
 	}
@@ -145,65 +134,117 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 
 	//write current time
 	firebase::Future<void> currentTimeFunc = dbRef.Child("LastAuthTime").SetValue(firebase::database::ServerTimestamp());
-	if (!waitForCompletion(currentTimeFunc, "Write current auth time to database process") ||
+	if (!waitForCompletion(stopToken, currentTimeFunc, "Write current auth time to database process") ||
 		currentTimeFunc.error() != firebase::database::kErrorNone)
 	{
 		//write error
 		writeToLog("Write current time to database - ERROR");
 		//thread shutdown
-		clientThreadClose();
 		writeToLog("Client thread closed");
 		return;
 	}
 
-	unique_lock<mutex> dbExchangeLock(clientExchangeData.sMutex, std::defer_lock);
+	//operations taken from queue wait in window and are started while window is not full
+	FBEasyInFlightWindow<dbInFlightOperation> operationsWindow;
+	std::deque<dbExchangeData> takenOperations;
+	uint64_t eventsCount = 0;
 	while (1)
 	{
-		// ? std::condition_variable - ??
-		//check database transactions state
-		dbExchangeLock.lock();
-		if (clientExchangeData.sValue.transactionActive)
+		//wait for operations (if window can take them), completion of started operations (firebase callback),
+		//nearest timeout or stop request
+		clientOperations.WaitEvents(stopToken, operationsWindow.FreeSlots() > 0, eventsCount, operationsWindow.NearestDeadline());
+		if (stopToken.stop_requested())
 		{
-			if (clientExchangeData.sValue.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_SET)
+			//stop
+			break;
+		}
+		operationsWindow.Configure(clientInFlightLimit, clientPathOrdering, std::chrono::milliseconds(clientOperationTimeout));
+
+		//complete operations with finished futures, fail operations with timeout
+		operationsWindow.Complete(std::chrono::steady_clock::now(),
+			[](dbOperationsWindow::windowEntry& started) { return started.operation.future.status() != firebase::kFutureStatusPending; },
+			[&](dbOperationsWindow::windowEntry& started)
 			{
-				//set
-				if (database != nullptr)
+				//latency
+				unique_lock<mutex> latencyLock(clientLatency.sMutex);
+				clientLatency.sValue.Add(std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now() - started.startTime).count());
+				latencyLock.unlock();
+				if (started.operation.operation.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_SET)
 				{
-					clientThreadProcessSET(*database);
-				}				
+					clientThreadCompleteSET(started.operation);
+				}
+				else if (started.operation.operation.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_UPDATE)
+				{
+					clientThreadCompleteUPDATE(started.operation);
+				}
+				else
+				{
+					clientThreadCompleteGET(started.operation);
+				}
+			},
+			[&](dbOperationsWindow::windowEntry& started)
+			{
+				writeToLog("ERROR: database operation timeout, path = " + (started.orderKeys.empty() ? string("") : started.orderKeys.front()) +
+					(started.orderKeys.size() > 1 ? " (+" + std::to_string(started.orderKeys.size() - 1) + " paths)" : ""));
+				failOperation(started.operation.operation);
+				lock_guard<mutex> latencyLock(clientLatency.sMutex);
+				clientLatency.sValue.timeouts++;
+			},
+			[&](dbOperationsWindow::windowEntry& started)
+			{
+				writeToLog("ERROR: timed out database operation not completed, its elements are released, path = " +
+					(started.orderKeys.empty() ? string("") : started.orderKeys.front()));
+				lock_guard<mutex> latencyLock(clientLatency.sMutex);
+				clientLatency.sValue.released++;
+			});
+
+		//take queued operations while window has free slots, producers are not blocked while operations are processed
+		clientOperations.Take(takenOperations, operationsWindow.FreeSlots());
+		for (dbExchangeData& operation : takenOperations)
+		{
+			std::vector<string> orderKeys = getOrderKeys(operation);
+			operationsWindow.Add({ .operation = std::move(operation) }, std::move(orderKeys));
+		}
+		takenOperations.clear();
+
+		//start operations while in-flight window is not full
+		operationsWindow.Start([&](dbOperationsWindow::windowEntry& started)
+		{
+			bool isStarted = false;
+			if (started.operation.operation.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_SET)
+			{
+				//set
+				isStarted = clientThreadStartSET(*database, started.operation);
 			}
-			else if (clientExchangeData.sValue.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_GET)
+			else if (started.operation.operation.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_GET)
 			{
 				//get
-				if (database != nullptr)
-				{
-					clientThreadProcessGET(*database);
-				}
+				isStarted = clientThreadStartGET(*database, started.operation);
+			}
+			else if (started.operation.operation.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_UPDATE)
+			{
+				//update (batch)
+				isStarted = clientThreadStartUPDATE(*database, started.operation);
 			}
 			else
 			{
 				//unknown
-				writeToLog("Internal error: transaction active but unknown transaction type");
+				writeToLog("Internal error: operation queued but unknown transaction type");
 			}
-		}
-		dbExchangeLock.unlock();
-
-		//check thread start/stop flag
-		lock_clientThreadWork.lock();
-		if (!clientThreadWork.sValue)
-		{
-			//stop
-			lock_clientThreadWork.unlock();
-			break;
-		}
-		lock_clientThreadWork.unlock();
-
-		//pause
-		std::this_thread::sleep_for(std::chrono::milliseconds(clientThreadUpdatePeriod));
+			if (isStarted)
+			{
+				setCompletionCallback(started.operation.future);
+			}
+			return isStarted;
+		});
 	}
 
+	//not completed "set" and "update" operations are failed: started and waiting in window
+	//(operations in queue are failed after thread exit)
+	operationsWindow.Abort([](dbOperationsWindow::windowEntry& entry) { failOperation(entry.operation.operation); });
+
 	//thread shutdown
-	clientThreadClose();
 	writeToLog("Client thread closed");
 }
 //*********************************************************************************************************//
@@ -212,17 +253,21 @@ void FirebaseDBEasyAdapter::clientThreadProcess()
 /* function for close client thread */
 void FirebaseDBEasyAdapter::clientThreadClose()
 {
-	//set client thread work flag
-	unique_lock<mutex> lock_clientThreadWork(clientThreadWork.sMutex);
-	clientThreadWork.sValue = false;
-	lock_clientThreadWork.unlock();
+	//stop request, waiting client thread is woken by it
+	clientThread.request_stop();
 
-	//*****
-	//here to add a check that thread really stopped
-	//*****
+	//completion callbacks of firebase futures can be called after thread exit
+	if (clientCompletionTarget != nullptr)
+	{
+		lock_guard<mutex> targetLock(clientCompletionTarget->sMutex);
+		clientCompletionTarget->sValue = nullptr;
+	}
 
-	//zero thread pointer before exit
-	clientThread = nullptr;
+	//wait for thread exit (thread can not join itself)
+	if (clientThread.joinable() && clientThread.get_id() != std::this_thread::get_id())
+	{
+		clientThread.join();
+	}
 }
 //*********************************************************************************************************//
 
@@ -276,180 +321,266 @@ bool FirebaseDBEasyAdapter::getDBRefFromPath(const string& path, const string& k
 //*********************************************************************************************************//
 
 //*********************************************************************************************************//
-/* function for process "set" database value */
-void FirebaseDBEasyAdapter::clientThreadProcessSET(const firebase::database::Database& fbDatabase)
+/* util function - normalized paths of database elements, keys for per-path ordering */
+std::vector<string> FirebaseDBEasyAdapter::getOrderKeys(const dbExchangeData& operation)
 {
-	//call this function only after lock clientExchangeData mutex!
-
-	//set value for database element
-	auto dbSetValueForRef = [&]<typename dataType>(firebase::database::DatabaseReference& dbRef, dataType& elVal) -> bool
+	//batch: all its element paths, ordered only with operations on same (parent, child) elements
+	if (operation.transactionType == dbExchangeData::DBTransactionType::DB_TRANSACTION_UPDATE)
 	{
-		//set value and get firebase future object
-		firebase::Future<void> setTransactionProc = dbRef.SetValue(elVal);
-		if (!waitForCompletion(setTransactionProc, "Exchange data process - set database value") ||
-			setTransactionProc.error() != firebase::database::kErrorNone)
+		std::vector<string> orderKeys;
+		const std::map<string, firebase::Variant>* batchValues = static_cast<const std::map<string, firebase::Variant>*>(operation.value.get());
+		if (batchValues != nullptr)
 		{
-			//write error
-			writeToLog("Set database value - ERROR");
-			return false;
+			orderKeys.reserve(batchValues->size());
+			for (const std::pair<const string, firebase::Variant>& batchValue : *batchValues)
+			{
+				orderKeys.push_back(batchValue.first);
+			}
 		}
-		return true;
-	};
+		return orderKeys;
+	}
+	return { FBEasyBatch::ElementPath(operation.path, operation.key) };
+}
+//*********************************************************************************************************//
 
-	//run "set" on complete handler
-	auto onSetHandler = [&](bool param)
+//*********************************************************************************************************//
+/* util function - fail not completed operation: "set" and "update" handlers get false, "get" handler is not called */
+void FirebaseDBEasyAdapter::failOperation(dbExchangeData& operation)
+{
+	if (operation.transactionType != dbExchangeData::DBTransactionType::DB_TRANSACTION_GET)
 	{
-		if (clientExchangeData.sValue.onComplHandler != nullptr)
-		{
-			setOnComplHandler* onSetH = reinterpret_cast<setOnComplHandler*>(clientExchangeData.sValue.onComplHandler);
-			(*onSetH)(param);
-		}
-	};
+		callSetHandler(operation, false);
+	}
+}
+//*********************************************************************************************************//
 
+//*********************************************************************************************************//
+/* function for fail operations left in queue (client thread is not working) */
+void FirebaseDBEasyAdapter::failQueuedOperations()
+{
+	std::deque<dbExchangeData> queuedOperations;
+	clientOperations.Take(queuedOperations);
+	for (dbExchangeData& operation : queuedOperations)
+	{
+		failOperation(operation);
+	}
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* util function - run "set" on complete handler */
+void FirebaseDBEasyAdapter::callSetHandler(dbExchangeData& operation, bool result)
+{
+	if (operation.onComplHandler != nullptr)
+	{
+		setOnComplHandler* onSetH = static_cast<setOnComplHandler*>(operation.onComplHandler.get());
+		(*onSetH)(result);
+	}
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* function for start "set" database value */
+bool FirebaseDBEasyAdapter::clientThreadStartSET(const firebase::database::Database& fbDatabase, dbInFlightOperation& inFlight)
+{
+	dbExchangeData& operation = inFlight.operation;
 	try
 	{
 		//check input data
-		if (clientExchangeData.sValue.value == nullptr ||
-			(clientExchangeData.sValue.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_INT &&
-				clientExchangeData.sValue.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING) ||
-			clientExchangeData.sValue.key.empty() ||
-			clientExchangeData.sValue.clientName.empty())
+		if (operation.value == nullptr ||
+			(operation.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_INT &&
+				operation.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING) ||
+			operation.key.empty() ||
+			operation.clientName.empty())
 		{
 			throw FBEasyResult::FBE_DBSET_PROCESS_INPUT_PARAMS_ERROR;
 		}
 
 		//access to database reference
 		firebase::database::DatabaseReference dbSetRef;
-		if (!getDBRefFromPath(clientExchangeData.sValue.path,
-			clientExchangeData.sValue.key,
-			clientExchangeData.sValue.clientName,
+		if (!getDBRefFromPath(operation.path,
+			operation.key,
+			operation.clientName,
 			fbDatabase,
 			dbSetRef))
 		{
 			throw FBEasyResult::FBE_DBSET_PROCESS_DB_ACCESS_ERROR;
 		}
 
-		//set database element value
+		//set database element value, firebase future object is checked by client thread
 		int* intVal = nullptr;
 		string* strVal = nullptr;
-		switch (clientExchangeData.sValue.valueType)
+		switch (operation.valueType)
 		{
 			case dbExchangeData::DBValueType::DB_VALUE_TYPE_INT:
-				intVal = reinterpret_cast<int*>(clientExchangeData.sValue.value.get());
-				if (intVal == nullptr || !dbSetValueForRef(dbSetRef, *intVal))
+				intVal = reinterpret_cast<int*>(operation.value.get());
+				if (intVal == nullptr)
 				{
 					throw FBEasyResult::FBE_DBSET_PROCESS_DB_SETVAL_ERROR;
 				}
+				inFlight.future = dbSetRef.SetValue(*intVal);
 			break;
 
 			case dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING:
-				strVal = reinterpret_cast<string*>(clientExchangeData.sValue.value.get());
-				if (strVal == nullptr || !dbSetValueForRef(dbSetRef, *strVal))
+				strVal = reinterpret_cast<string*>(operation.value.get());
+				if (strVal == nullptr)
 				{
 					throw FBEasyResult::FBE_DBSET_PROCESS_DB_SETVAL_ERROR;
 				}
+				inFlight.future = dbSetRef.SetValue(*strVal);
 			break;
 		}
-
-		//run on complete handler
-		onSetHandler(true);
+		return true;
 	}
 	catch (FBEasyResult errCode)
 	{
-		//save error code
-
 		//run on complete handler
-		onSetHandler(false);
+		callSetHandler(operation, false);
 		//message
 		writeToLog("Database SET value process - return error with code = " + std::to_string(static_cast<int>(errCode)));
 	}
 	catch (...)
 	{
-		//save error code - unknown error
-
 		//run on complete handler
-		onSetHandler(false);
+		callSetHandler(operation, false);
 		//message
 		writeToLog("Database SET value process - return unknown error");
 	}
-	//clear
-	clientExchangeData.sValue.clear();
+	return false;
 }
 //*********************************************************************************************************//
 
 //*********************************************************************************************************//
-/* function for process "get" database value */
-void FirebaseDBEasyAdapter::clientThreadProcessGET(const firebase::database::Database& fbDatabase)
+/* function for complete "set" database value (future is not pending) */
+void FirebaseDBEasyAdapter::clientThreadCompleteSET(dbInFlightOperation& inFlight)
 {
-	//call this function only after lock clientExchangeData mutex!
+	try
+	{
+		if (inFlight.future.status() != firebase::kFutureStatusComplete ||
+			inFlight.future.error() != firebase::database::kErrorNone)
+		{
+			//write error
+			logFutureError(inFlight.future, "Exchange data process - set database value");
+			writeToLog("Set database value - ERROR");
+			throw FBEasyResult::FBE_DBSET_PROCESS_DB_SETVAL_ERROR;
+		}
 
-	//run "get" on complete handler
-	auto onGetHandler = [&]<typename dataType>(dataType& resValue)
+		//run on complete handler
+		callSetHandler(inFlight.operation, true);
+	}
+	catch (FBEasyResult errCode)
 	{
-		//clientExchangeData.sValue.onComplHandler not nullptr!
-		getOnComplHandler<dataType>* onGetH = static_cast<getOnComplHandler<dataType>*>(clientExchangeData.sValue.onComplHandler);
-		(*onGetH)(resValue);
-	};
+		//run on complete handler
+		callSetHandler(inFlight.operation, false);
+		//message
+		writeToLog("Database SET value process - return error with code = " + std::to_string(static_cast<int>(errCode)));
+	}
+	catch (...)
+	{
+		//message
+		writeToLog("Database SET value process - return unknown error");
+	}
+}
+//*********************************************************************************************************//
 
+//*********************************************************************************************************//
+/* function for start "get" database value */
+bool FirebaseDBEasyAdapter::clientThreadStartGET(const firebase::database::Database& fbDatabase, dbInFlightOperation& inFlight)
+{
+	dbExchangeData& operation = inFlight.operation;
 	try
 	{
 		//check input data
-		if (clientExchangeData.sValue.value != nullptr ||
-			(clientExchangeData.sValue.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_INT &&
-				clientExchangeData.sValue.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING) ||
-			clientExchangeData.sValue.key.empty() ||
-			clientExchangeData.sValue.clientName.empty() ||
-			clientExchangeData.sValue.onComplHandler == nullptr)
+		if (operation.value != nullptr ||
+			(operation.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_INT &&
+				operation.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING) ||
+			operation.key.empty() ||
+			operation.clientName.empty() ||
+			operation.onComplHandler == nullptr)
 		{
 			throw FBEasyResult::FBE_DBGET_PROCESS_INPUT_PARAMS_ERROR;
 		}
 
 		//access to database reference
 		firebase::database::DatabaseReference dbGetRef;
-		if (!getDBRefFromPath(clientExchangeData.sValue.path,
-			clientExchangeData.sValue.key,
-			clientExchangeData.sValue.clientName,
+		if (!getDBRefFromPath(operation.path,
+			operation.key,
+			operation.clientName,
 			fbDatabase,
 			dbGetRef))
 		{
 			throw FBEasyResult::FBE_DBGET_PROCESS_DB_ACCESS_ERROR;
 		}
 
-		//get database value
-		firebase::Future<firebase::database::DataSnapshot> getTransactionProc = dbGetRef.GetValue();
-		if (!waitForCompletion(getTransactionProc, "Exchange data process - get database value") ||
-			getTransactionProc.error() != firebase::database::kErrorNone)
+		//get database value, firebase future object is checked by client thread
+		inFlight.future = dbGetRef.GetValue();
+		return true;
+	}
+	catch (FBEasyResult errCode)
+	{
+		//message
+		writeToLog("Database GET value process - return error with code = " + std::to_string(static_cast<int>(errCode)));
+	}
+	catch (...)
+	{
+		//message
+		writeToLog("Database GET value process - return unknown error");
+	}
+	return false;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* function for complete "get" database value (future is not pending) */
+void FirebaseDBEasyAdapter::clientThreadCompleteGET(dbInFlightOperation& inFlight)
+{
+	//run "get" on complete handler
+	auto onGetHandler = [&]<typename dataType>(dataType& resValue)
+	{
+		//operation.onComplHandler not nullptr!
+		getOnComplHandler<dataType>* onGetH = static_cast<getOnComplHandler<dataType>*>(inFlight.operation.onComplHandler.get());
+		(*onGetH)(resValue);
+	};
+
+	try
+	{
+		if (inFlight.future.status() != firebase::kFutureStatusComplete ||
+			inFlight.future.error() != firebase::database::kErrorNone ||
+			inFlight.future.result_void() == nullptr)
 		{
 			//write error
+			logFutureError(inFlight.future, "Exchange data process - get database value");
 			writeToLog("Get database value - ERROR");
 			throw FBEasyResult::FBE_DBGET_PROCESS_DB_GETVAL_ERROR;
 		}
+		const firebase::database::DataSnapshot* getResult =
+			static_cast<const firebase::database::DataSnapshot*>(inFlight.future.result_void());
 
 		//parse returned value depending data type
-		switch (clientExchangeData.sValue.valueType)
+		switch (inFlight.operation.valueType)
 		{
 			case dbExchangeData::DBValueType::DB_VALUE_TYPE_INT:
 				//check requested type matching with database type
-				if (!getTransactionProc.result()->value().is_int64())
+				if (!getResult->value().is_int64())
 				{
 					throw FBEasyResult::FBE_DBGET_PROCESS_REQ_TYPE_NOT_MATCH_DB_TYPE;
 				}
 				//get value and run on complete handler
 				{
-					int intVal = static_cast<int>(getTransactionProc.result()->value().int64_value());
+					int intVal = static_cast<int>(getResult->value().int64_value());
 					onGetHandler(intVal);
 				}
 			break;
 
 			case dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING:
 				//check requested type matching with database type
-				if (!getTransactionProc.result()->value().is_string())
+				if (!getResult->value().is_string())
 				{
 					throw FBEasyResult::FBE_DBGET_PROCESS_REQ_TYPE_NOT_MATCH_DB_TYPE;
 				}
 				//get value and run on complete handler
 				{
-					string strVal(getTransactionProc.result()->value().string_value());
+					string strVal(getResult->value().string_value());
 					onGetHandler(strVal);
 				}
 			break;
@@ -457,20 +588,92 @@ void FirebaseDBEasyAdapter::clientThreadProcessGET(const firebase::database::Dat
 	}
 	catch (FBEasyResult errCode)
 	{
-		//save error code
-		
 		//message
 		writeToLog("Database GET value process - return error with code = " + std::to_string(static_cast<int>(errCode)));
 	}
 	catch (...)
 	{
-		//save error code - unknown error
-		
 		//message
 		writeToLog("Database GET value process - return unknown error");
 	}
-	//clear
-	clientExchangeData.sValue.clear();
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* function for start "update" of database elements values (batch) */
+bool FirebaseDBEasyAdapter::clientThreadStartUPDATE(const firebase::database::Database& fbDatabase, dbInFlightOperation& inFlight)
+{
+	dbExchangeData& operation = inFlight.operation;
+	try
+	{
+		//check input data
+		if (operation.value == nullptr ||
+			operation.valueType != dbExchangeData::DBValueType::DB_VALUE_TYPE_BATCH ||
+			operation.clientName.empty())
+		{
+			throw FBEasyResult::FBE_DBUPDATE_PROCESS_INPUT_PARAMS_ERROR;
+		}
+
+		//all paths of batch are relative to client node
+		firebase::database::DatabaseReference dbUpdateRef = fbDatabase.GetReference(operation.clientName.c_str());
+		if (!dbUpdateRef.is_valid())
+		{
+			throw FBEasyResult::FBE_DBUPDATE_PROCESS_DB_ACCESS_ERROR;
+		}
+
+		//one multi-path write, firebase future object is checked by client thread
+		std::map<string, firebase::Variant>* batchValues = reinterpret_cast<std::map<string, firebase::Variant>*>(operation.value.get());
+		inFlight.future = dbUpdateRef.UpdateChildren(*batchValues);
+		return true;
+	}
+	catch (FBEasyResult errCode)
+	{
+		//run on complete handler
+		callSetHandler(operation, false);
+		//message
+		writeToLog("Database UPDATE values process - return error with code = " + std::to_string(static_cast<int>(errCode)));
+	}
+	catch (...)
+	{
+		//run on complete handler
+		callSetHandler(operation, false);
+		//message
+		writeToLog("Database UPDATE values process - return unknown error");
+	}
+	return false;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* function for complete "update" of database elements values (future is not pending) */
+void FirebaseDBEasyAdapter::clientThreadCompleteUPDATE(dbInFlightOperation& inFlight)
+{
+	try
+	{
+		if (inFlight.future.status() != firebase::kFutureStatusComplete ||
+			inFlight.future.error() != firebase::database::kErrorNone)
+		{
+			//write error
+			logFutureError(inFlight.future, "Exchange data process - update database values");
+			writeToLog("Update database values - ERROR");
+			throw FBEasyResult::FBE_DBUPDATE_PROCESS_DB_UPDATE_ERROR;
+		}
+
+		//run on complete handler
+		callSetHandler(inFlight.operation, true);
+	}
+	catch (FBEasyResult errCode)
+	{
+		//run on complete handler
+		callSetHandler(inFlight.operation, false);
+		//message
+		writeToLog("Database UPDATE values process - return error with code = " + std::to_string(static_cast<int>(errCode)));
+	}
+	catch (...)
+	{
+		//message
+		writeToLog("Database UPDATE values process - return unknown error");
+	}
 }
 //*********************************************************************************************************//
 
@@ -487,35 +690,35 @@ bool FirebaseDBEasyAdapter::ConnectToFirebase()
 		return false;
 	}
 	//check - thread already working
-	unique_lock<mutex> lock_clientThreadWork(clientThreadWork.sMutex);
-	if (clientThreadWork.sValue)
+	if (clientThreadActive.exchange(true))
 	{
 		lastErrorCode = FBEasyResult::FBE_CLIENT_ALREADY_WORK;
 		return false;
 	}
-	//release mutex
-	lock_clientThreadWork.unlock();
+	//previous thread closed by itself (error) - wait for its exit and detach its completion callbacks
+	clientThreadClose();
+	//target of firebase completion callbacks of new thread
+	clientCompletionTarget = std::make_shared<syncData<FirebaseDBEasyAdapter*>>();
+	clientCompletionTarget->sValue = this;
 
-	//start new thread
+	//start new thread, thurther work into thread
 	try
 	{
-		clientThread = new thread([&]() {this->clientThreadProcess(); });
-		if (clientThread == nullptr)
+		clientThread = std::jthread([this](std::stop_token stopToken)
 		{
-			throw -1;
-		}
+			this->clientThreadProcess(stopToken);
+			//operations queued to stopped thread are not started
+			failQueuedOperations();
+			clientThreadActive = false;
+		});
 	}
 	catch (...)
 	{
 		lastErrorCode = FBEasyResult::FBE_CANT_START_CLIENT_THREAD;
-		clientThread = nullptr;
+		clientThreadActive = false;
 		return false;
 	}
 
-	//detach thread
-	//thurther work into thread
-	clientThread->detach();
-
 	return true;
 }
 //*********************************************************************************************************//
@@ -14,12 +14,22 @@
 #include "firebase/future.h"
 #include "firebase/util.h"
 
+#include "FirebaseEasyOperations.h"
+
 #include <iostream>
 #include <string>
 #include <thread>
 #include <mutex>
+#include <stop_token>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <algorithm>
+#include <deque>
+#include <vector>
+#include <map>
+#include <typeinfo>
 #include "windows.h"
 
 namespace FBEasy
@@ -56,9 +66,117 @@ namespace FBEasy
 		FBE_DBGET_PROCESS_DB_ACCESS_ERROR = -17,
 		FBE_DBGET_PROCESS_DB_GETVAL_ERROR = -18,
 		FBE_DBGET_PROCESS_REQ_TYPE_NOT_MATCH_DB_TYPE = -19,
+		FBE_DB_OPERATIONS_QUEUE_IS_FULL = -20,
+		FBE_DBUPDATE_PROCESS_INPUT_PARAMS_ERROR = -21,
+		FBE_DBUPDATE_PROCESS_DB_ACCESS_ERROR = -22,
+		FBE_DBUPDATE_PROCESS_DB_UPDATE_ERROR = -23,
 		FBE_RES_DEFAULT = FBE_RES_OK
 	};
 
+	//histogram of database operations latency: start of operation -> completion of its future
+	struct FBEasyLatencyHistogram
+	{
+		//upper bounds of buckets, msec (last bucket - greater latency)
+		static constexpr int64_t BUCKET_BOUNDS[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000 };
+		static constexpr size_t BUCKETS_COUNT = sizeof(BUCKET_BOUNDS) / sizeof(BUCKET_BOUNDS[0]) + 1;
+		uint64_t buckets[BUCKETS_COUNT] = {};
+		//completed operations, operations failed by timeout and timed out operations released without completion
+		uint64_t count = 0;
+		uint64_t timeouts = 0;
+		uint64_t released = 0;
+		int64_t sumUsec = 0;
+		int64_t maxUsec = 0;
+
+		void Add(int64_t latencyUsec)
+		{
+			size_t bucket = 0;
+			while (bucket < BUCKETS_COUNT - 1 && latencyUsec > BUCKET_BOUNDS[bucket] * 1000)
+			{
+				bucket++;
+			}
+			buckets[bucket]++;
+			count++;
+			sumUsec += latencyUsec;
+			maxUsec = latencyUsec > maxUsec ? latencyUsec : maxUsec;
+		}
+
+		//upper bound of bucket with requested quantile (0.5 - median), msec; 0 - no data
+		int64_t Quantile(double quantile) const
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+			uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+			uint64_t passed = 0;
+			for (size_t bucket = 0; bucket < BUCKETS_COUNT - 1; bucket++)
+			{
+				passed += buckets[bucket];
+				if (passed >= rank)
+				{
+					return BUCKET_BOUNDS[bucket];
+				}
+			}
+			return maxUsec / 1000;
+		}
+
+		double AverageMsec() const
+		{
+			return count > 0 ? static_cast<double>(sumUsec) / static_cast<double>(count) / 1000.0 : 0.0;
+		}
+	};
+
+	//values of many database elements for one multi-path write (FirebaseDBEasyAdapter::SetElementsValues)
+	struct FBEasyBatch
+	{
+		//element path relative to client node -> value
+		std::map<string, firebase::Variant> values = {};
+
+		//normalized path of database element: "path/key", '/' separators, without empty elements
+		static string ElementPath(const string& path, const string& key)
+		{
+			string elementPath = path + "/" + key;
+			std::replace(elementPath.begin(), elementPath.end(), '\\', '/');
+			elementPath.erase(std::unique(elementPath.begin(), elementPath.end(), [](char a, char b) { return a == '/' && b == '/'; }), elementPath.end());
+			if (!elementPath.empty() && elementPath.front() == '/')
+			{
+				elementPath.erase(0, 1);
+			}
+			if (!elementPath.empty() && elementPath.back() == '/')
+			{
+				elementPath.pop_back();
+			}
+			return elementPath;
+		}
+
+		//add or replace value of element (int and string values are supported)
+		template <typename elemDataType>
+		bool Add(const string& path, const string& key, const elemDataType& value)
+		{
+			if (key.empty() || (typeid(elemDataType) != typeid(int) && typeid(elemDataType) != typeid(string)))
+			{
+				return false;
+			}
+			values[ElementPath(path, key)] = firebase::Variant(value);
+			return true;
+		}
+
+		size_t Size() const
+		{
+			return values.size();
+		}
+
+		bool Empty() const
+		{
+			return values.empty();
+		}
+
+		void Clear()
+		{
+			values.clear();
+		}
+	};
+
 	//class for easy firebase database access
 	class FirebaseDBEasyAdapter
 	{
@@ -77,35 +195,34 @@ namespace FBEasy
 			string clientName = "", clientEMail = "", clientPassword = "";
 			//firebase json config
 			string firebaseJSONConfig = "";
-			//database client thread object
-			thread* clientThread = nullptr;
-			//database client thread update period, msec
-			int clientThreadUpdatePeriod = 10;
-			//flag and mutex for database client thread state
-			syncData<bool> clientThreadWork = {.sValue = false};
+			//database client thread object, stop request - by its stop source
+			std::jthread clientThread;
+			//database client thread state: started and not finished yet
+			std::atomic_bool clientThreadActive = false;
 			//mutex - iostream
 			mutex mutex_IOStream;
 			//handlers called on completion of functions set and get
 			using setOnComplHandler = function<void(bool)>;
 			template <typename dataType>
 			using getOnComplHandler = function<void(dataType&)>;
-			//struct and mutex for exchange value with database
+			//one database operation (set or get) for client thread
 			struct dbExchangeData
 			{
 				enum class DBValueType
 				{
 					DB_VALUE_TYPE_NONE = 0,
 					DB_VALUE_TYPE_INT,
-					DB_VALUE_TYPE_STRING
+					DB_VALUE_TYPE_STRING,
+					DB_VALUE_TYPE_BATCH
 				};
 				enum class DBTransactionType
 				{
 					DB_TRANSACTION_NONE = 0,
 					DB_TRANSACTION_SET,
-					DB_TRANSACTION_GET
+					DB_TRANSACTION_GET,
+					DB_TRANSACTION_UPDATE
 				};
-				//transaction state flag and transaction type
-				bool transactionActive = false;
+				//transaction type
 				DBTransactionType transactionType = DBTransactionType::DB_TRANSACTION_NONE;
 				//type of value and pointer to dynamically allocated object
 				DBValueType valueType = DBValueType::DB_VALUE_TYPE_NONE;
@@ -115,8 +232,8 @@ namespace FBEasy
 				string key = "";
 				//name of client - copy for thread
 				string clientName = "";
-				//pointer to handler, called after transaction
-				void* onComplHandler = nullptr;
+				//copy of handler, called after transaction (setOnComplHandler or getOnComplHandler<type>)
+				shared_ptr<void> onComplHandler = nullptr;
 				//function for reset struct data
 				void clear()
 				{
@@ -125,15 +242,64 @@ namespace FBEasy
 						value.reset();
 					}
 					valueType = DBValueType::DB_VALUE_TYPE_NONE;
-					transactionActive = false;
 					transactionType = DBTransactionType::DB_TRANSACTION_NONE;
 					path = "";
 					key = "";
 					clientName = "";
-					onComplHandler = nullptr;
+					onComplHandler.reset();
+				}
+			};
+			//queue of operations: filled by any thread, client thread takes as many operations as its window can hold
+			//client thread waits here for new operations, completion callbacks or stop request
+			FBEasyOperationsQueue<dbExchangeData> clientOperations;
+			//operation started by client thread, waits for firebase future
+			struct dbInFlightOperation
+			{
+				dbExchangeData operation;
+				firebase::FutureBase future;
+			};
+			using dbOperationsWindow = FBEasyInFlightWindow<dbInFlightOperation>;
+			//max number of operations taken by client thread: started and not completed, waiting for start
+			std::atomic<size_t> clientInFlightLimit = 16;
+			//operation with element is started only after completion of previous operation with same element
+			std::atomic_bool clientPathOrdering = true;
+			//started operation is failed if its future is not completed in this time, msec
+			//(next operations with same element wait for completion of its future)
+			std::atomic_int clientOperationTimeout = 30000;
+			//target of completion callbacks, set to nullptr when client thread is closed (callback can be called later)
+			shared_ptr<syncData<FirebaseDBEasyAdapter*>> clientCompletionTarget = nullptr;
+			//operations latency
+			syncData<FBEasyLatencyHistogram> clientLatency;
+
+			//value type code for supported types
+			template <typename elemDataType>
+			static bool getValueType(dbExchangeData::DBValueType& valueType)
+			{
+				if (typeid(elemDataType) == typeid(int))
+				{
+					valueType = dbExchangeData::DBValueType::DB_VALUE_TYPE_INT;
+				}
+				else if (typeid(elemDataType) == typeid(string))
+				{
+					valueType = dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING;
+				}
+				else
+				{
+					return false;
+				}
+				return true;
+			}
+
+			//add prepared operation to queue
+			bool pushOperation(dbExchangeData& operation)
+			{
+				if (!clientOperations.Push(std::move(operation)))
+				{
+					lastErrorCode = FBEasyResult::FBE_DB_OPERATIONS_QUEUE_IS_FULL;
+					return false;
 				}
-			};			
-			syncData <dbExchangeData> clientExchangeData;
+				return true;
+			}
 			
 			//function for check one parameter
 			inline bool assert_param(const string& str, FBEasyResult errCode)
@@ -154,8 +320,8 @@ namespace FBEasy
 			{
 				//close thread
 				clientThreadClose();
-				//clear transaction data
-				clientExchangeData.sValue.clear();
+				//fail queued operations
+				failQueuedOperations();
 			}
 
 			//client config function - set parameters
@@ -215,13 +381,51 @@ namespace FBEasy
 			//disconnect from firebase server
 			bool DisconnectFromFirebase();
 
+			//max number of operations waiting for client thread (set/get return false when queue is full)
+			void SetOperationsQueueLimit(size_t limit)
+			{
+				clientOperations.SetLimit(limit);
+			}
+			//max number of operations started by client thread and waiting for server response
+			//(operations taken from queue and waiting for start of previous operation with same element are counted too)
+			void SetInFlightLimit(size_t limit)
+			{
+				clientInFlightLimit = limit > 0 ? limit : 1;
+			}
+			//true - operations with same element are completed in order of calls (default), batches are ordered
+			//only with operations on same, parent or child elements of their paths,
+			//false - all operations are started as soon as in-flight window allows
+			void SetPathOrdering(bool ordering)
+			{
+				clientPathOrdering = ordering;
+			}
+			//max time of started operation, msec (operation is failed after it, but next operations with same element
+			//are started only after completion of its firebase future - write can be still applied by SDK,
+			//or after one more timeout if future is not completed - e.g. write held by SDK while offline)
+			void SetOperationTimeout(int timeoutMsec)
+			{
+				clientOperationTimeout = timeoutMsec > 0 ? timeoutMsec : 1;
+			}
+			//copy of operations latency histogram
+			FBEasyLatencyHistogram GetLatencyHistogram()
+			{
+				lock_guard<mutex> latencyLock(clientLatency.sMutex);
+				return clientLatency.sValue;
+			}
+			//number of operations waiting for client thread
+			size_t GetQueuedOperationsCount()
+			{
+				return clientOperations.Size();
+			}
+
 			//*********************************************************************************************************//
 			/* set value for one database element */
+			/* operation is queued, handler is copied and called from client thread */
 			template <typename elemDataType>
 			bool SetElementValue(const string& path,
 				const string& key,
 				const elemDataType& value,
-				setOnComplHandler& onComplHandler = nullptr)
+				const setOnComplHandler& onComplHandler = nullptr)
 			{
 				//check input params
 				if (!assert_param(key, FBEasyResult::FBE_KEY_VALUE_IS_EMPTY))
@@ -229,68 +433,44 @@ namespace FBEasy
 					return false;
 				}
 
-				//lock db exchange data struct
-				lock_guard<mutex> dbExDataLock(clientExchangeData.sMutex);
-				//check - already active or not
-				if (clientExchangeData.sValue.transactionActive)
+				//prepare operation without queue lock
+				dbExchangeData operation;
+				if (!getValueType<elemDataType>(operation.valueType))
 				{
-					lastErrorCode = FBEasyResult::FBE_DB_TRANSACTION_ALREADY_ACTIVE;
+					lastErrorCode = FBEasyResult::FBE_UNSUPPORTED_VALUE_DATA_TYPE;
 					return false;
 				}
-				//set params
 				try
 				{
-					//clear .value pointer
-					if (clientExchangeData.sValue.value != nullptr)
-					{
-						clientExchangeData.sValue.value.reset();
-					}
-					//set datatype
-					if (typeid(elemDataType) == typeid(int))
-					{						
-						clientExchangeData.sValue.valueType = dbExchangeData::DBValueType::DB_VALUE_TYPE_INT;
-					}
-					else if (typeid(elemDataType) == typeid(string))
-					{
-						clientExchangeData.sValue.valueType = dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING;
-					}
-					else
-					{
-						lastErrorCode = FBEasyResult::FBE_UNSUPPORTED_VALUE_DATA_TYPE;
-						return false;
-					}
-					//try alloc memory for new object
-					clientExchangeData.sValue.value.reset(new elemDataType(value));
-					//check again - after alloc memory
-					if (clientExchangeData.sValue.value == nullptr)
+					//copy value and handler
+					operation.value.reset(new elemDataType(value));
+					if (onComplHandler != nullptr)
 					{
-						throw - 1;
+						operation.onComplHandler.reset(new setOnComplHandler(onComplHandler));
 					}
+					operation.path = path;
+					operation.key = key;
+					operation.clientName = clientName;
 				}
 				catch (...)
 				{
 					lastErrorCode = FBEasyResult::FBE_MEMORY_ALLOC_OPERATION_ERROR;
 					return false;
 				}
-				clientExchangeData.sValue.path = path;
-				clientExchangeData.sValue.key = key;
-				clientExchangeData.sValue.clientName = clientName;
-				clientExchangeData.sValue.onComplHandler = reinterpret_cast<void*>(&onComplHandler);
-				//set transaction active flag
-				clientExchangeData.sValue.transactionType = dbExchangeData::DBTransactionType::DB_TRANSACTION_SET;
-				clientExchangeData.sValue.transactionActive = true;
-
-				//free mutex and exit
-				return true;
+				operation.transactionType = dbExchangeData::DBTransactionType::DB_TRANSACTION_SET;
+
+				//to queue
+				return pushOperation(operation);
 			}
 			//*********************************************************************************************************//
 
 			//*********************************************************************************************************//
 			/* get value of one database element */
+			/* operation is queued, handler is copied and called from client thread */
 			template <typename elemDataType>
 			bool GetElementValue(const string& path,
 				const string& key,
-				getOnComplHandler<elemDataType>& onComplHandler = nullptr)
+				const getOnComplHandler<elemDataType>& onComplHandler = nullptr)
 			{
 				//check input params
 				if (!assert_param(key, FBEasyResult::FBE_KEY_VALUE_IS_EMPTY))
@@ -302,47 +482,69 @@ namespace FBEasy
 					lastErrorCode = FBEasyResult::FBE_INPUT_PARAM_ERROR;
 					return false;
 				}
-				
-				//lock db exchange data struct
-				lock_guard<mutex> dbExDataLock(clientExchangeData.sMutex);
-				//check - already active or not
-				if (clientExchangeData.sValue.transactionActive)
+
+				//prepare operation without queue lock
+				dbExchangeData operation;
+				if (!getValueType<elemDataType>(operation.valueType))
 				{
-					lastErrorCode = FBEasyResult::FBE_DB_TRANSACTION_ALREADY_ACTIVE;
+					lastErrorCode = FBEasyResult::FBE_UNSUPPORTED_VALUE_DATA_TYPE;
 					return false;
 				}
-
-				//set params
-				//value data type
-				if (typeid(elemDataType) == typeid(int))
+				try
 				{
-					clientExchangeData.sValue.valueType = dbExchangeData::DBValueType::DB_VALUE_TYPE_INT;
+					//copy handler
+					operation.onComplHandler.reset(new getOnComplHandler<elemDataType>(onComplHandler));
+					operation.path = path;
+					operation.key = key;
+					operation.clientName = clientName;
 				}
-				else if (typeid(elemDataType) == typeid(string))
+				catch (...)
 				{
-					clientExchangeData.sValue.valueType = dbExchangeData::DBValueType::DB_VALUE_TYPE_STRING;
+					lastErrorCode = FBEasyResult::FBE_MEMORY_ALLOC_OPERATION_ERROR;
+					return false;
 				}
-				else
+				operation.transactionType = dbExchangeData::DBTransactionType::DB_TRANSACTION_GET;
+
+				//to queue
+				return pushOperation(operation);
+			}
+			//*********************************************************************************************************//
+
+			//*********************************************************************************************************//
+			/* set values of many database elements by one multi-path write (UpdateChildren) */
+			/* batch is written atomically, handler is copied and called once for whole batch from client thread */
+			bool SetElementsValues(const FBEasyBatch& batch,
+				const setOnComplHandler& onComplHandler = nullptr)
+			{
+				//check input params
+				if (batch.Empty())
 				{
-					lastErrorCode = FBEasyResult::FBE_UNSUPPORTED_VALUE_DATA_TYPE;
+					lastErrorCode = FBEasyResult::FBE_INPUT_PARAM_ERROR;
 					return false;
 				}
-				//value pointer
-				if (clientExchangeData.sValue.value != nullptr)
+
+				//prepare operation without queue lock
+				dbExchangeData operation;
+				operation.valueType = dbExchangeData::DBValueType::DB_VALUE_TYPE_BATCH;
+				try
+				{
+					//copy values and handler
+					operation.value.reset(new std::map<string, firebase::Variant>(batch.values));
+					if (onComplHandler != nullptr)
+					{
+						operation.onComplHandler.reset(new setOnComplHandler(onComplHandler));
+					}
+					operation.clientName = clientName;
+				}
+				catch (...)
 				{
-					clientExchangeData.sValue.value.reset();
+					lastErrorCode = FBEasyResult::FBE_MEMORY_ALLOC_OPERATION_ERROR;
+					return false;
 				}
-				//path, key, client name
-				clientExchangeData.sValue.path = path;
-				clientExchangeData.sValue.key = key;
-				clientExchangeData.sValue.clientName = clientName;
-				//get database element value on complete handler
-				clientExchangeData.sValue.onComplHandler = reinterpret_cast<void*>(&onComplHandler);
-				//set transaction active flag
-				clientExchangeData.sValue.transactionType = dbExchangeData::DBTransactionType::DB_TRANSACTION_GET;
-				clientExchangeData.sValue.transactionActive = true;
+				operation.transactionType = dbExchangeData::DBTransactionType::DB_TRANSACTION_UPDATE;
 
-				return true;
+				//to queue
+				return pushOperation(operation);
 			}
 			//*********************************************************************************************************//
 		
@@ -360,21 +562,44 @@ namespace FBEasy
 				Sleep(msec);
 			}
 			
-			//wait operation completion and return message if need
-			bool waitForCompletion(const firebase::FutureBase& future, const string& operationName)
+			//called from firebase completion callback: wake client thread
+			void onFutureCompletion()
+			{
+				clientOperations.NotifyEvent();
+			}
+
+			//wake client thread when future is completed (callback is called immediately if future is completed already)
+			void setCompletionCallback(const firebase::FutureBase& future)
 			{
-				while (future.status() == firebase::kFutureStatusPending)
+				shared_ptr<syncData<FirebaseDBEasyAdapter*>> target = clientCompletionTarget;
+				future.OnCompletion([target](const firebase::FutureBase&)
 				{
-					waitAndEvents(100);
-					//check thread start/stop flag
-					unique_lock<mutex> lock_clientThreadWork(clientThreadWork.sMutex);
-					if (!clientThreadWork.sValue)
+					lock_guard<mutex> targetLock(target->sMutex);
+					if (target->sValue != nullptr)
 					{
-						//stop
-						return false;
+						target->sValue->onFutureCompletion();
 					}
-					lock_clientThreadWork.unlock();
+				});
+			}
+
+			//wait operation completion (or stop request) and return message if need
+			bool waitForCompletion(std::stop_token stopToken, const firebase::FutureBase& future, const string& operationName)
+			{
+				setCompletionCallback(future);
+				clientOperations.Wait(stopToken, std::chrono::steady_clock::time_point::max(),
+					[&]() { return future.status() != firebase::kFutureStatusPending; });
+				if (future.status() == firebase::kFutureStatusPending)
+				{
+					//stop
+					return false;
 				}
+				logFutureError(future, operationName);
+				return true;
+			}
+
+			//message for failed or invalid operation result
+			void logFutureError(const firebase::FutureBase& future, const string& operationName)
+			{
 				if (future.status() != firebase::kFutureStatusComplete)
 				{
 					writeToLog("ERROR: " + operationName + " returned an invalid result.");
@@ -383,24 +608,47 @@ namespace FBEasy
 				{
 					writeToLog("ERROR: " + operationName + " returned error " + std::to_string(future.error()) + ": " + string(future.error_message()));
 				}
-				return true;
 			}
 
 			//client thread function
-			void clientThreadProcess();
+			void clientThreadProcess(std::stop_token stopToken);
 
-			//function for close client thread
+			//function for close client thread: stop request and wait for thread exit
 			void clientThreadClose();
 
 			//util function - access to database element using path and key
 			bool getDBRefFromPath(const string& path, const string& key, const string& clName,
 				const firebase::database::Database& database, firebase::database::DatabaseReference& dbRef);
 
-			//function for process "set" database value
-			void clientThreadProcessSET(const firebase::database::Database& fbDatabase);
+			//util function - normalized paths of database elements, keys for per-path ordering
+			static std::vector<string> getOrderKeys(const dbExchangeData& operation);
+
+			//util function - run "set" on complete handler
+			static void callSetHandler(dbExchangeData& operation, bool result);
+
+			//util function - fail not completed operation ("set" and "update" handlers get false)
+			static void failOperation(dbExchangeData& operation);
+
+			//function for fail operations left in queue (client thread is not working)
+			void failQueuedOperations();
+
+			//function for start "set" database value, false - operation failed and completed
+			bool clientThreadStartSET(const firebase::database::Database& fbDatabase, dbInFlightOperation& inFlight);
+
+			//function for complete "set" database value after future completion
+			void clientThreadCompleteSET(dbInFlightOperation& inFlight);
+
+			//function for start "get" database value, false - operation failed and completed
+			bool clientThreadStartGET(const firebase::database::Database& fbDatabase, dbInFlightOperation& inFlight);
+
+			//function for complete "get" database value after future completion
+			void clientThreadCompleteGET(dbInFlightOperation& inFlight);
+
+			//function for start "update" of database elements values (batch), false - operation failed and completed
+			bool clientThreadStartUPDATE(const firebase::database::Database& fbDatabase, dbInFlightOperation& inFlight);
 
-			//function for process "get" database value
-			void clientThreadProcessGET(const firebase::database::Database& fbDatabase);
+			//function for complete "update" of database elements values after future completion
+			void clientThreadCompleteUPDATE(dbInFlightOperation& inFlight);
 	};
 }
 
@@ -0,0 +1,359 @@
+//*********************************************************************************************************//
+//Firebase Easy Operations header file
+//Operations queue and in-flight window of database client thread (without firebase SDK dependencies)
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#ifndef FIREBASE_EASY_OPERATIONS
+#define FIREBASE_EASY_OPERATIONS
+
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+namespace FBEasy
+{
+	//bounded queue of operations: filled by any thread, client thread takes operations in parts
+	//client thread also waits here for events of started operations (completion callbacks)
+	template <typename operationType>
+	class FBEasyOperationsQueue
+	{
+		private:
+			std::mutex queueMutex;
+			//client thread waits for new operations, events or stop request
+			std::condition_variable_any queueCond;
+			std::deque<operationType> operations = {};
+			//max number of queued operations
+			size_t operationsLimit = 4096;
+			//number of events (completed futures), waiting thread compares it with last seen value
+			uint64_t eventsCount = 0;
+
+		public:
+			//add operation, false - queue is full
+			bool Push(operationType&& operation)
+			{
+				std::unique_lock<std::mutex> queueLock(queueMutex);
+				if (operations.size() >= operationsLimit)
+				{
+					return false;
+				}
+				operations.push_back(std::move(operation));
+				queueLock.unlock();
+				//wake client thread
+				queueCond.notify_one();
+				return true;
+			}
+
+			//event from other thread (completion of started operation): wake waiting thread
+			void NotifyEvent()
+			{
+				std::unique_lock<std::mutex> queueLock(queueMutex);
+				eventsCount++;
+				queueLock.unlock();
+				queueCond.notify_all();
+			}
+
+			//wait until predicate is true (called under queue lock), stop request or deadline
+			//return predicate result
+			template <typename predicateType>
+			bool Wait(std::stop_token stopToken, std::chrono::steady_clock::time_point deadline, predicateType&& predicate)
+			{
+				std::unique_lock<std::mutex> queueLock(queueMutex);
+				if (deadline == std::chrono::steady_clock::time_point::max())
+				{
+					return queueCond.wait(queueLock, stopToken, predicate);
+				}
+				return queueCond.wait_until(queueLock, stopToken, deadline, predicate);
+			}
+
+			//wait for events after lastEventsCount (updated), queued operations (if takeOperations), stop request or deadline
+			//takeOperations = false - queued operations do not wake thread (it can not take them now)
+			void WaitEvents(std::stop_token stopToken, bool takeOperations, uint64_t& lastEventsCount,
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max())
+			{
+				std::unique_lock<std::mutex> queueLock(queueMutex);
+				auto hasEvents = [&]() { return (takeOperations && !operations.empty()) || eventsCount != lastEventsCount; };
+				if (deadline == std::chrono::steady_clock::time_point::max())
+				{
+					queueCond.wait(queueLock, stopToken, hasEvents);
+				}
+				else
+				{
+					queueCond.wait_until(queueLock, stopToken, deadline, hasEvents);
+				}
+				lastEventsCount = eventsCount;
+			}
+
+			//move up to maxCount operations from queue front to target, return number of taken operations
+			size_t Take(std::deque<operationType>& target, size_t maxCount = SIZE_MAX)
+			{
+				std::lock_guard<std::mutex> queueLock(queueMutex);
+				size_t takeCount = operations.size() < maxCount ? operations.size() : maxCount;
+				for (size_t i = 0; i < takeCount; i++)
+				{
+					target.push_back(std::move(operations.front()));
+					operations.pop_front();
+				}
+				return takeCount;
+			}
+
+			void SetLimit(size_t limit)
+			{
+				std::lock_guard<std::mutex> queueLock(queueMutex);
+				operationsLimit = limit > 0 ? limit : 1;
+			}
+
+			size_t Size()
+			{
+				std::lock_guard<std::mutex> queueLock(queueMutex);
+				return operations.size();
+			}
+	};
+
+	//true if sorted lists of element paths ("a/b/c") have same, parent or child paths
+	//(writes to them must be ordered)
+	inline bool FBEasyPathsOverlap(const std::vector<std::string>& sortedPaths, const std::vector<std::string>& otherSortedPaths)
+	{
+		for (const std::string& path : sortedPaths)
+		{
+			//same path
+			if (std::binary_search(otherSortedPaths.begin(), otherSortedPaths.end(), path))
+			{
+				return true;
+			}
+			//child paths: "path/..." are sorted together
+			std::string childPrefix = path + "/";
+			std::vector<std::string>::const_iterator child = std::lower_bound(otherSortedPaths.begin(), otherSortedPaths.end(), childPrefix);
+			if (child != otherSortedPaths.end() && child->compare(0, childPrefix.size(), childPrefix) == 0)
+			{
+				return true;
+			}
+			//parent paths
+			for (size_t slashPos = path.find('/'); slashPos != std::string::npos; slashPos = path.find('/', slashPos + 1))
+			{
+				if (std::binary_search(otherSortedPaths.begin(), otherSortedPaths.end(), path.substr(0, slashPos)))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	//in-flight window of client thread: operations taken from queue wait here and are started
+	//while number of started and not completed operations is less than limit
+	//waiting operations are counted against limit too, so client thread never holds more than limit operations
+	//timed out operation is failed but stays in window till completion: next operation with same element
+	//is not started while previous write can be still applied (timed out operations are not counted against limit)
+	//timed out operation is released after one more timeout (future may never resolve, e.g. offline write),
+	//operations waiting behind it are not counted against limit, so other elements are not blocked
+	template <typename operationType>
+	class FBEasyInFlightWindow
+	{
+		public:
+			struct windowEntry
+			{
+				operationType operation;
+				//sorted normalized paths of written or read database elements (per-path ordering)
+				std::vector<std::string> orderKeys = {};
+				//start time and time of failure by timeout (of release for timed out operation)
+				std::chrono::steady_clock::time_point startTime = {};
+				std::chrono::steady_clock::time_point deadline = {};
+				//failed by timeout, waits for completion as path blocker
+				bool timedOut = false;
+				//waiting operation blocked by timed out operation (directly or behind other blocked one)
+				bool blocked = false;
+			};
+
+		private:
+			//taken from queue and not started yet, started operations
+			std::deque<windowEntry> waiting = {};
+			std::vector<windowEntry> inFlight = {};
+			size_t timedOutCount = 0;
+			//waiting operations blocked by timed out operations
+			size_t blockedCount = 0;
+			//max number of started and not completed operations
+			size_t inFlightLimit = 16;
+			//operation with element is started only after completion of previous operation with same element
+			bool pathOrdering = true;
+			//started operation is failed if it is not completed in this time
+			std::chrono::milliseconds operationTimeout = std::chrono::milliseconds(30000);
+
+			//mark waiting operations blocked by timed out operations
+			void updateBlocked()
+			{
+				blockedCount = 0;
+				for (typename std::deque<windowEntry>::iterator entry = waiting.begin(); entry != waiting.end(); entry++)
+				{
+					auto overlaps = [&](const windowEntry& previous) { return FBEasyPathsOverlap(entry->orderKeys, previous.orderKeys); };
+					entry->blocked = pathOrdering && timedOutCount > 0 &&
+						(std::any_of(inFlight.begin(), inFlight.end(), [&](const windowEntry& started) { return started.timedOut && overlaps(started); }) ||
+						std::any_of(waiting.begin(), entry, [&](const windowEntry& previous) { return previous.blocked && overlaps(previous); }));
+					blockedCount += entry->blocked ? 1 : 0;
+				}
+			}
+
+		public:
+			void Configure(size_t limit, bool ordering, std::chrono::milliseconds timeout)
+			{
+				inFlightLimit = limit > 0 ? limit : 1;
+				pathOrdering = ordering;
+				operationTimeout = timeout;
+			}
+
+			//number of operations which can be taken from queue now
+			size_t FreeSlots() const
+			{
+				size_t usedSlots = waiting.size() - blockedCount + inFlight.size() - timedOutCount;
+				return usedSlots < inFlightLimit ? inFlightLimit - usedSlots : 0;
+			}
+
+			//add operation taken from queue, it is started by Start
+			//orderKeys - element paths of operation (one for set/get, all paths of batch), sorted here
+			void Add(operationType&& operation, std::vector<std::string>&& orderKeys)
+			{
+				std::sort(orderKeys.begin(), orderKeys.end());
+				waiting.push_back({ .operation = std::move(operation), .orderKeys = std::move(orderKeys) });
+			}
+
+			//check started operations, completed operations are removed from window
+			//isCompleted(windowEntry&) - true if operation is completed, onComplete(windowEntry&), onTimeout(windowEntry&)
+			//and onRelease(windowEntry&) - handlers
+			//timed out operation is removed silently on its completion, or by onRelease after one more timeout
+			template <typename completedCheck, typename completeHandler, typename timeoutHandler, typename releaseHandler>
+			void Complete(std::chrono::steady_clock::time_point timeNow, completedCheck&& isCompleted,
+				completeHandler&& onComplete, timeoutHandler&& onTimeout, releaseHandler&& onRelease)
+			{
+				for (size_t i = 0; i < inFlight.size();)
+				{
+					if (!isCompleted(inFlight[i]))
+					{
+						if (!inFlight[i].timedOut && timeNow >= inFlight[i].deadline)
+						{
+							onTimeout(inFlight[i]);
+							inFlight[i].timedOut = true;
+							inFlight[i].deadline += operationTimeout;
+							timedOutCount++;
+						}
+						else if (inFlight[i].timedOut && timeNow >= inFlight[i].deadline)
+						{
+							//not completed after one more timeout - stop blocking its elements
+							onRelease(inFlight[i]);
+							timedOutCount--;
+							inFlight[i] = std::move(inFlight.back());
+							inFlight.pop_back();
+							continue;
+						}
+						i++;
+						continue;
+					}
+					if (inFlight[i].timedOut)
+					{
+						timedOutCount--;
+					}
+					else
+					{
+						onComplete(inFlight[i]);
+					}
+					inFlight[i] = std::move(inFlight.back());
+					inFlight.pop_back();
+				}
+				updateBlocked();
+			}
+
+			//start waiting operations in order while window is not full
+			//onStart(windowEntry&) - false if operation failed to start (it is completed and removed)
+			template <typename startHandler>
+			void Start(startHandler&& onStart)
+			{
+				for (typename std::deque<windowEntry>::iterator entry = waiting.begin();
+					entry != waiting.end() && inFlight.size() - timedOutCount < inFlightLimit;)
+				{
+					//per-path ordering: wait for completion of previous operations with same (parent, child) elements,
+					//started or still waiting before this one
+					auto overlaps = [&](const windowEntry& previous) { return FBEasyPathsOverlap(entry->orderKeys, previous.orderKeys); };
+					if (pathOrdering && (std::any_of(inFlight.begin(), inFlight.end(), overlaps) ||
+						std::any_of(waiting.begin(), entry, overlaps)))
+					{
+						entry++;
+						continue;
+					}
+					windowEntry started = std::move(*entry);
+					entry = waiting.erase(entry);
+					started.startTime = std::chrono::steady_clock::now();
+					started.deadline = started.startTime + operationTimeout;
+					if (onStart(started))
+					{
+						inFlight.push_back(std::move(started));
+					}
+				}
+				updateBlocked();
+			}
+
+			//nearest timeout or release time of started operations, time_point::max() - no started operations
+			std::chrono::steady_clock::time_point NearestDeadline() const
+			{
+				std::chrono::steady_clock::time_point nearestDeadline = std::chrono::steady_clock::time_point::max();
+				for (const windowEntry& started : inFlight)
+				{
+					if (started.deadline < nearestDeadline)
+					{
+						nearestDeadline = started.deadline;
+					}
+				}
+				return nearestDeadline;
+			}
+
+			//remove all started and waiting operations, onAbort(windowEntry&) is called for every one not failed yet
+			template <typename abortHandler>
+			void Abort(abortHandler&& onAbort)
+			{
+				for (windowEntry& started : inFlight)
+				{
+					if (!started.timedOut)
+					{
+						onAbort(started);
+					}
+				}
+				inFlight.clear();
+				timedOutCount = 0;
+				blockedCount = 0;
+				for (windowEntry& entry : waiting)
+				{
+					onAbort(entry);
+				}
+				waiting.clear();
+			}
+
+			//started and not timed out operations
+			size_t InFlightCount() const
+			{
+				return inFlight.size() - timedOutCount;
+			}
+
+			//timed out operations waiting for completion
+			size_t TimedOutCount() const
+			{
+				return timedOutCount;
+			}
+
+			size_t WaitingCount() const
+			{
+				return waiting.size();
+			}
+
+			//waiting operations blocked by timed out operations (not counted against limit)
+			size_t BlockedCount() const
+			{
+				return blockedCount;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,429 @@
+//*********************************************************************************************************//
+//TEST: Firebase Easy Adapter client thread benchmarks (without firebase SDK and network)
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#include "FirebaseEasyOperations.h"
+
+#include <iostream>
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+#include <algorithm>
+
+using namespace FBEasy;
+
+//operation like FirebaseDBEasyAdapter::dbExchangeData: copies of value, path, key and handler
+struct benchOperation
+{
+	std::shared_ptr<void> value = nullptr;
+	std::string path = "";
+	std::string key = "";
+	std::string clientName = "";
+	std::shared_ptr<void> onComplHandler = nullptr;
+	std::chrono::steady_clock::time_point submitTime = {};
+};
+
+//prepare operation as SetElementValue does (outside of queue lock)
+static benchOperation makeOperation(int value, const std::function<void(bool)>& onComplHandler)
+{
+	benchOperation operation;
+	operation.value.reset(new int(value));
+	operation.onComplHandler.reset(new std::function<void(bool)>(onComplHandler));
+	operation.path = "TemperatureValues\\GPU";
+	operation.key = "GPU Temperature";
+	operation.clientName = "Bench client";
+	return operation;
+}
+
+//quantile of samples (sorted in place), usec
+static double quantileUsec(std::vector<int64_t>& samplesNsec, double quantile)
+{
+	if (samplesNsec.empty())
+	{
+		return 0.0;
+	}
+	size_t rank = static_cast<size_t>(quantile * static_cast<double>(samplesNsec.size() - 1));
+	std::nth_element(samplesNsec.begin(), samplesNsec.begin() + rank, samplesNsec.end());
+	return static_cast<double>(samplesNsec[rank]) / 1000.0;
+}
+
+//*********************************************************************************************************//
+/* producers submit throughput: producers build and push operations, client thread takes them in parts */
+static void benchSubmitThroughput(int producersCount, int operationsPerProducer)
+{
+	FBEasyOperationsQueue<benchOperation> operationsQueue;
+	std::atomic<uint64_t> takenCount = 0;
+
+	//client thread: wait for operations and take all queued
+	std::jthread clientThread([&](std::stop_token stopToken)
+	{
+		std::deque<benchOperation> taken;
+		uint64_t eventsCount = 0;
+		while (!stopToken.stop_requested())
+		{
+			operationsQueue.WaitEvents(stopToken, true, eventsCount);
+			takenCount += operationsQueue.Take(taken);
+			taken.clear();
+		}
+	});
+
+	std::function<void(bool)> onComplHandler = [](bool) {};
+	std::vector<std::vector<int64_t>> pushTimes(producersCount);
+	std::vector<uint64_t> fullCounts(producersCount, 0);
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	std::vector<std::thread> producers;
+	for (int p = 0; p < producersCount; p++)
+	{
+		producers.emplace_back([&, p]()
+		{
+			pushTimes[p].reserve(operationsPerProducer);
+			for (int i = 0; i < operationsPerProducer; i++)
+			{
+				std::chrono::steady_clock::time_point submitStart = std::chrono::steady_clock::now();
+				benchOperation operation = makeOperation(i, onComplHandler);
+				while (!operationsQueue.Push(std::move(operation)))
+				{
+					//queue is full - caller gets FBE_DB_OPERATIONS_QUEUE_IS_FULL, retry
+					fullCounts[p]++;
+					operation = makeOperation(i, onComplHandler);
+					std::this_thread::yield();
+				}
+				pushTimes[p].push_back((std::chrono::steady_clock::now() - submitStart).count());
+			}
+		});
+	}
+	for (std::thread& producer : producers)
+	{
+		producer.join();
+	}
+	uint64_t totalCount = static_cast<uint64_t>(producersCount) * operationsPerProducer;
+	while (takenCount < totalCount)
+	{
+		std::this_thread::yield();
+	}
+	double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	clientThread.request_stop();
+
+	std::vector<int64_t> allTimes;
+	uint64_t fullCount = 0;
+	for (int p = 0; p < producersCount; p++)
+	{
+		allTimes.insert(allTimes.end(), pushTimes[p].begin(), pushTimes[p].end());
+		fullCount += fullCounts[p];
+	}
+	std::cout << "submit throughput: producers " << producersCount <<
+		", operations " << totalCount <<
+		", " << static_cast<uint64_t>(static_cast<double>(totalCount) / elapsedSec) << " ops/s" <<
+		", submit p50 " << quantileUsec(allTimes, 0.5) << " us" <<
+		", p99 " << quantileUsec(allTimes, 0.99) << " us" <<
+		", queue full " << fullCount << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* submit to dispatch latency: single producer, client thread is idle (waits) at every push */
+/* time from push of operation to its take by woken client thread */
+static void benchDispatchLatency(int operationsCount, std::chrono::microseconds pushInterval)
+{
+	FBEasyOperationsQueue<benchOperation> operationsQueue;
+	std::vector<int64_t> dispatchTimes;
+	dispatchTimes.reserve(operationsCount);
+
+	//client thread: wait for operations and take all queued
+	std::jthread clientThread([&](std::stop_token stopToken)
+	{
+		std::deque<benchOperation> taken;
+		uint64_t eventsCount = 0;
+		while (!stopToken.stop_requested())
+		{
+			operationsQueue.WaitEvents(stopToken, true, eventsCount);
+			operationsQueue.Take(taken);
+			std::chrono::steady_clock::time_point dispatchTime = std::chrono::steady_clock::now();
+			for (const benchOperation& operation : taken)
+			{
+				dispatchTimes.push_back((dispatchTime - operation.submitTime).count());
+			}
+			taken.clear();
+		}
+	});
+
+	std::function<void(bool)> onComplHandler = [](bool) {};
+	for (int i = 0; i < operationsCount; i++)
+	{
+		benchOperation operation = makeOperation(i, onComplHandler);
+		operation.submitTime = std::chrono::steady_clock::now();
+		operationsQueue.Push(std::move(operation));
+		std::this_thread::sleep_for(pushInterval);
+	}
+	clientThread.request_stop();
+	clientThread.join();
+
+	std::cout << "dispatch latency: operations " << dispatchTimes.size() <<
+		", p50 " << quantileUsec(dispatchTimes, 0.5) << " us" <<
+		", p99 " << quantileUsec(dispatchTimes, 0.99) << " us" <<
+		", max " << quantileUsec(dispatchTimes, 1.0) << " us" << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* fake database backend: started operation is completed by backend thread after injected latency, */
+/* completion wakes client thread like firebase OnCompletion callback */
+class fakeBackend
+{
+	private:
+		std::mutex backendMutex;
+		std::condition_variable_any backendCond;
+		//completion time -> completion flag of operation (fake future)
+		std::multimap<std::chrono::steady_clock::time_point, std::shared_ptr<std::atomic_bool>> pending = {};
+		std::function<void()> onCompletion = nullptr;
+		std::jthread backendThread;
+
+	public:
+		fakeBackend(const std::function<void()>& completionCallback) : onCompletion(completionCallback)
+		{
+			backendThread = std::jthread([this](std::stop_token stopToken)
+			{
+				std::unique_lock<std::mutex> backendLock(backendMutex);
+				while (!stopToken.stop_requested())
+				{
+					if (pending.empty())
+					{
+						backendCond.wait(backendLock, stopToken, [this]() { return !pending.empty(); });
+						continue;
+					}
+					std::chrono::steady_clock::time_point completionTime = pending.begin()->first;
+					if (std::chrono::steady_clock::now() < completionTime)
+					{
+						backendCond.wait_until(backendLock, stopToken, completionTime,
+							[&]() { return pending.begin()->first < completionTime; });
+						continue;
+					}
+					std::shared_ptr<std::atomic_bool> future = pending.begin()->second;
+					pending.erase(pending.begin());
+					backendLock.unlock();
+					*future = true;
+					onCompletion();
+					backendLock.lock();
+				}
+			});
+		}
+
+		//start operation, returned flag is set when operation is completed
+		std::shared_ptr<std::atomic_bool> Start(std::chrono::microseconds latency)
+		{
+			std::shared_ptr<std::atomic_bool> future = std::make_shared<std::atomic_bool>(false);
+			std::unique_lock<std::mutex> backendLock(backendMutex);
+			pending.emplace(std::chrono::steady_clock::now() + latency, future);
+			backendLock.unlock();
+			backendCond.notify_one();
+			return future;
+		}
+};
+
+//operation for fake backend
+struct fakeOperation
+{
+	int pathIndex = 0;
+	//number of operation with same path
+	int sequence = 0;
+	std::shared_ptr<std::atomic_bool> future = nullptr;
+};
+
+/* in-flight window throughput: client thread loop of FirebaseDBEasyAdapter (queue, window, completion events) */
+/* against fake backend with latency in [latency/2, latency*3/2], operations are distributed over pathsCount paths */
+static void benchInFlightWindow(size_t inFlightLimit, bool pathOrdering, int operationsCount, int pathsCount,
+	std::chrono::microseconds latency)
+{
+	FBEasyOperationsQueue<fakeOperation> operationsQueue;
+	operationsQueue.SetLimit(operationsCount);
+	fakeBackend backend([&]() { operationsQueue.NotifyEvent(); });
+	std::atomic<int> completedCount = 0;
+	//completed operations of path out of order, max number of started and held (started + waiting) operations
+	int orderViolations = 0;
+	size_t maxInFlight = 0;
+	size_t maxHeld = 0;
+	std::vector<int64_t> operationTimes;
+	operationTimes.reserve(operationsCount);
+
+	std::jthread clientThread([&](std::stop_token stopToken)
+	{
+		FBEasyInFlightWindow<fakeOperation> operationsWindow;
+		operationsWindow.Configure(inFlightLimit, pathOrdering, std::chrono::milliseconds(30000));
+		std::deque<fakeOperation> takenOperations;
+		std::vector<int> lastCompleted(pathsCount, -1);
+		std::mt19937 latencyRandom(12345);
+		std::uniform_int_distribution<int64_t> latencyDistribution(latency.count() / 2, latency.count() * 3 / 2);
+		uint64_t eventsCount = 0;
+		while (1)
+		{
+			operationsQueue.WaitEvents(stopToken, operationsWindow.FreeSlots() > 0, eventsCount, operationsWindow.NearestDeadline());
+			if (stopToken.stop_requested())
+			{
+				break;
+			}
+			operationsWindow.Complete(std::chrono::steady_clock::now(),
+				[](FBEasyInFlightWindow<fakeOperation>::windowEntry& started) { return started.operation.future->load(); },
+				[&](FBEasyInFlightWindow<fakeOperation>::windowEntry& started)
+				{
+					operationTimes.push_back((std::chrono::steady_clock::now() - started.startTime).count());
+					orderViolations += started.operation.sequence != lastCompleted[started.operation.pathIndex] + 1 ? 1 : 0;
+					lastCompleted[started.operation.pathIndex] = started.operation.sequence;
+					completedCount++;
+				},
+				[](FBEasyInFlightWindow<fakeOperation>::windowEntry&) {},
+				[](FBEasyInFlightWindow<fakeOperation>::windowEntry&) {});
+			operationsQueue.Take(takenOperations, operationsWindow.FreeSlots());
+			for (fakeOperation& operation : takenOperations)
+			{
+				std::vector<std::string> orderKeys = { "TemperatureValues/Sensor" + std::to_string(operation.pathIndex) };
+				operationsWindow.Add(std::move(operation), std::move(orderKeys));
+			}
+			takenOperations.clear();
+			maxHeld = std::max(maxHeld, operationsWindow.InFlightCount() + operationsWindow.WaitingCount());
+			operationsWindow.Start([&](FBEasyInFlightWindow<fakeOperation>::windowEntry& started)
+			{
+				started.operation.future = backend.Start(std::chrono::microseconds(latencyDistribution(latencyRandom)));
+				return true;
+			});
+			maxInFlight = std::max(maxInFlight, operationsWindow.InFlightCount());
+		}
+	});
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < operationsCount; i++)
+	{
+		operationsQueue.Push({ .pathIndex = i % pathsCount, .sequence = i / pathsCount });
+	}
+	while (completedCount < operationsCount)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	clientThread.request_stop();
+	clientThread.join();
+
+	std::cout << "in-flight window: limit " << inFlightLimit <<
+		", path ordering " << (pathOrdering ? "on" : "off") <<
+		", latency " << latency.count() / 1000 << " ms" <<
+		", " << static_cast<uint64_t>(static_cast<double>(operationsCount) / elapsedSec) << " ops/s" <<
+		", operation p50 " << quantileUsec(operationTimes, 0.5) / 1000.0 << " ms" <<
+		", max in flight " << maxInFlight <<
+		", max held " << maxHeld <<
+		", out of order " << orderViolations << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* operation whose future never resolves (e.g. write held by SDK while offline): first operation of path 0 */
+/* operations are pushed at fixed rate to small queue, other paths must not stall and queue must not be full */
+static void benchStuckOperation(size_t inFlightLimit, int operationsCount, int pathsCount, std::chrono::microseconds latency,
+	std::chrono::microseconds pushInterval, std::chrono::milliseconds operationTimeout)
+{
+	FBEasyOperationsQueue<fakeOperation> operationsQueue;
+	operationsQueue.SetLimit(64);
+	fakeBackend backend([&]() { operationsQueue.NotifyEvent(); });
+	std::atomic<int> completedCount = 0;
+	std::atomic<int> timedOutCount = 0;
+	std::atomic<int> releasedCount = 0;
+	size_t maxBlocked = 0;
+	//start time of path 0 operation after stuck one
+	std::chrono::steady_clock::time_point pathUnblockTime = {};
+
+	std::jthread clientThread([&](std::stop_token stopToken)
+	{
+		FBEasyInFlightWindow<fakeOperation> operationsWindow;
+		operationsWindow.Configure(inFlightLimit, true, operationTimeout);
+		std::deque<fakeOperation> takenOperations;
+		uint64_t eventsCount = 0;
+		while (1)
+		{
+			operationsQueue.WaitEvents(stopToken, operationsWindow.FreeSlots() > 0, eventsCount, operationsWindow.NearestDeadline());
+			if (stopToken.stop_requested())
+			{
+				break;
+			}
+			operationsWindow.Complete(std::chrono::steady_clock::now(),
+				[](FBEasyInFlightWindow<fakeOperation>::windowEntry& started) { return started.operation.future->load(); },
+				[&](FBEasyInFlightWindow<fakeOperation>::windowEntry&) { completedCount++; },
+				[&](FBEasyInFlightWindow<fakeOperation>::windowEntry&) { timedOutCount++; },
+				[&](FBEasyInFlightWindow<fakeOperation>::windowEntry&) { releasedCount++; });
+			operationsQueue.Take(takenOperations, operationsWindow.FreeSlots());
+			for (fakeOperation& operation : takenOperations)
+			{
+				std::vector<std::string> orderKeys = { "TemperatureValues/Sensor" + std::to_string(operation.pathIndex) };
+				operationsWindow.Add(std::move(operation), std::move(orderKeys));
+			}
+			takenOperations.clear();
+			operationsWindow.Start([&](FBEasyInFlightWindow<fakeOperation>::windowEntry& started)
+			{
+				bool isStuck = started.operation.pathIndex == 0 && started.operation.sequence == 0;
+				if (started.operation.pathIndex == 0 && started.operation.sequence == 1)
+				{
+					pathUnblockTime = started.startTime;
+				}
+				started.operation.future = isStuck ? std::make_shared<std::atomic_bool>(false) : backend.Start(latency);
+				return true;
+			});
+			maxBlocked = std::max(maxBlocked, operationsWindow.BlockedCount());
+		}
+	});
+
+	int rejectedCount = 0;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < operationsCount; i++)
+	{
+		std::this_thread::sleep_until(startTime + pushInterval * i);
+		if (!operationsQueue.Push({ .pathIndex = i % pathsCount, .sequence = i / pathsCount }))
+		{
+			rejectedCount++;
+		}
+	}
+	std::chrono::steady_clock::time_point waitEndTime = std::chrono::steady_clock::now() + operationTimeout * 3;
+	while (completedCount + rejectedCount < operationsCount - 1 && std::chrono::steady_clock::now() < waitEndTime)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	clientThread.request_stop();
+	clientThread.join();
+
+	std::cout << "stuck operation: limit " << inFlightLimit <<
+		", timeout " << operationTimeout.count() << " ms" <<
+		", completed " << completedCount << "/" << operationsCount - 1 <<
+		", rejected by full queue " << rejectedCount <<
+		", timed out " << timedOutCount << ", released " << releasedCount <<
+		", max blocked " << maxBlocked <<
+		", path unblocked after " << std::chrono::duration_cast<std::chrono::milliseconds>(pathUnblockTime - startTime).count() << " ms" << std::endl;
+}
+//*********************************************************************************************************//
+
+int main(int argc, char* argv[])
+{
+	for (int producersCount : { 1, 2, 4 })
+	{
+		benchSubmitThroughput(producersCount, 200000);
+	}
+	benchDispatchLatency(2000, std::chrono::microseconds(500));
+	for (size_t inFlightLimit : { 1, 4, 16, 64 })
+	{
+		benchInFlightWindow(inFlightLimit, true, 1000, 64, std::chrono::microseconds(5000));
+	}
+	//few paths: ordering limits parallelism, without ordering operations with same path complete out of order
+	benchInFlightWindow(64, true, 1000, 8, std::chrono::microseconds(5000));
+	benchInFlightWindow(64, false, 1000, 8, std::chrono::microseconds(5000));
+	//future of one operation never resolves: other paths continue, its path waits for timeout and release
+	benchStuckOperation(16, 1000, 8, std::chrono::microseconds(5000), std::chrono::microseconds(2000), std::chrono::milliseconds(200));
+
+	system("pause");
+
+	return 0;
+}
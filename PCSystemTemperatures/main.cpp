@@ -8,9 +8,19 @@
 
 #include "FirebaseEasyAdapter.h"
 #include "PCTemperaturesScanner.h"
+#include "SensorAggregator.h"
+#include "SensorHistory.h"
+#include "SensorRollup.h"
+#include "SensorDeadband.h"
+#include "SensorCompressedHistory.h"
+#include "SensorHistoryFile.h"
+#include "SensorQuantileSketch.h"
+#include "SensorAlerts.h"
 #include <fstream>
 #include <sstream>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 int main(int argc, char* argv[])
 {
@@ -55,9 +65,52 @@ int main(int argc, char* argv[])
 	//instead of mutex...
 	std::atomic_bool testFlag = false;
 
-	//PCTemperaturesScanner::GPUZTemperatures gpuzTemper;
-	PCTemperaturesScanner::AIDA64Temperatures gpuzTemper;
-	std::map<std::string, double> temperValues{};
+	//all sensors sources (GPU-Z, AIDA64), polled concurrently, keys "<source>:<sensor>"
+	PCTemperaturesScanner::SensorAggregator temperScanner;
+	temperScanner.AddProviders(PCTemperaturesScanner::SensorProviderRegistry::CreateDefault());
+	//poll every source just after it publishes new data
+	temperScanner.SetAdaptivePolling(true);
+	//last hour of samples (2 sec period), windows: 1 min, 10 min
+	PCTemperaturesScanner::SensorHistory temperHistory(1800, { 60 * 1000, 600 * 1000 });
+	//compressed local history for post-mortems: blocks of 1 hour, 3 days
+	PCTemperaturesScanner::SensorCompressedHistory temperCompressedHistory(1800, 72);
+	//on-disk history, kept between restarts: 256 chunks of 4096 records (24 MB)
+	PCTemperaturesScanner::SensorHistoryFile temperHistoryFile;
+	if (!temperHistoryFile.Open("PCTemperaturesHistory.bin", 4096, 256, 1024))
+	{
+		std::cout << "Can't open history file, error = " << temperHistoryFile.LastError() << std::endl;
+	}
+	//history file pages are written to disk every minute (and on exit), not only by system
+	const std::chrono::seconds historyFlushPeriod = std::chrono::seconds(60);
+	std::chrono::steady_clock::time_point historyFlushTime = std::chrono::steady_clock::now();
+	//rollups: 1 min and 1 hour buckets, uploaded when closed (one node per sensor per bucket)
+	PCTemperaturesScanner::SensorRollup temperRollup({ 60 * 1000, 3600 * 1000 }, 4096);
+	const std::string rollupLevelNames[] = { "1m", "1h" };
+	//per-minute quantile sketches, uploaded when closed (mergeable on server side)
+	PCTemperaturesScanner::SensorQuantiles temperQuantiles(60 * 1000, 100, 4096);
+	//alert rules (aggregated sensors keys)
+	PCTemperaturesScanner::SensorAlerts temperAlerts;
+	temperAlerts.AddRule({ .name = "CPUOverheat", .sensorName = "AIDA64:TCPU",
+		.type = PCTemperaturesScanner::SensorAlertType::ALERT_VALUE_ABOVE, .threshold = 85.0, .hysteresis = 5.0, .minDuration = 10 * 1000 });
+	temperAlerts.AddRule({ .name = "CPUFastRise", .sensorName = "AIDA64:TCPU",
+		.type = PCTemperaturesScanner::SensorAlertType::ALERT_RATE_ABOVE, .threshold = 5.0, .hysteresis = 2.0, .minDuration = 0 });
+	temperAlerts.AddRule({ .name = "GPUOverheat", .sensorName = "AIDA64:TGPU1",
+		.type = PCTemperaturesScanner::SensorAlertType::ALERT_VALUE_ABOVE, .threshold = 90.0, .hysteresis = 5.0, .minDuration = 10 * 1000 });
+	//current values: send only changes >= 0.5 and heartbeat every 10 min
+	PCTemperaturesScanner::SensorDeadband temperDeadband({ .absThreshold = 0.5, .relThreshold = 0.0, .maxSilence = 600 * 1000 });
+
+	//content of one batch for retry: deadband handles, closed rollups and quantiles
+	using uploadContent = std::pair<std::vector<PCTemperaturesScanner::SensorHandle>, FBEasy::FBEasyBatch>;
+	//content of failed batches, to send again with next batch (filled from client thread)
+	//deadband values are published again by next sample, closed rollups and quantiles are kept
+	struct
+	{
+		std::mutex retryMutex;
+		std::vector<PCTemperaturesScanner::SensorHandle> deadbandHandles;
+		FBEasy::FBEasyBatch closedElements;
+	} failedUploads;
+	//kept closed elements limit (~ 1 day of 1 min rollups and quantiles of 8 sensors)
+	const size_t maxFailedElements = 24 * 1024;
 
 	//work while not enter "exit"
 	std::function<void(bool)> setHandler = [&](bool res)
@@ -79,27 +132,111 @@ int main(int argc, char* argv[])
 	while (inputStr != "exit")
 	{
 		//get temperatures
-		gpuzTemper.UpdateTemperatures();
-		gpuzTemper.GetTemperatures(temperValues);
-		//and send to database
-		if (temperValues.size())
+		temperScanner.UpdateTemperatures();
+		PCTemperaturesScanner::SensorSnapshotRef temperValues = temperScanner.GetSnapshot();
+		//and send to database: all changes of one poll by one multi-path write
+		if (temperValues)
 		{
-			for (const auto& sensor : temperValues)
+			//alerts first, each by own write (ordered by alert element only, not behind bulk batches)
+			temperAlerts.EvaluateSnapshot(*temperValues, [&](const PCTemperaturesScanner::SensorAlertEvent& alertEvent)
 			{
-				testFlag = false;
-				testAdapter.SetElementValue(std::string("TemperatureSensors\\"),
-					sensor.first,
-					std::to_string(sensor.second),
+				testAdapter.SetElementValue(std::string("Alerts\\") + temperValues->Name(alertEvent.handle),
+					temperAlerts.GetRule(alertEvent.ruleId).name,
+					std::string(alertEvent.raised ? "raised:" : "cleared:") + std::to_string(alertEvent.ruleValue),
 					setHandler);
-				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			});
+
+			FBEasy::FBEasyBatch uploadBatch;
+			//handles and closed elements of this batch, for failure handler
+			auto batchContent = std::make_shared<uploadContent>();
+			//content of failed batches: publish values again, send closed elements with this batch
+			{
+				std::lock_guard<std::mutex> retryLock(failedUploads.retryMutex);
+				for (PCTemperaturesScanner::SensorHandle sensor : failedUploads.deadbandHandles)
+				{
+					temperDeadband.Invalidate(sensor);
+				}
+				failedUploads.deadbandHandles.clear();
+				batchContent->second.values.swap(failedUploads.closedElements.values);
+			}
+
+			temperHistory.AppendSnapshot(*temperValues);
+			temperCompressedHistory.AppendSnapshot(*temperValues);
+			temperHistoryFile.AppendSnapshot(*temperValues);
+			if (std::chrono::steady_clock::now() - historyFlushTime >= historyFlushPeriod)
+			{
+				temperHistoryFile.Flush();
+				historyFlushTime = std::chrono::steady_clock::now();
+			}
+			temperDeadband.Filter(*temperValues, [&](PCTemperaturesScanner::SensorHandle sensor)
+			{
+				uploadBatch.Add(std::string("TemperatureSensors\\"),
+					temperValues->Name(sensor),
+					std::to_string(temperValues->Value(sensor)));
+				batchContent->first.push_back(sensor);
+			});
+
+			//closed rollup buckets
+			temperRollup.AppendSnapshot(*temperValues);
+			temperRollup.CloseExpired(PCTemperaturesScanner::SensorTimestampNow());
+			PCTemperaturesScanner::SensorRollupBucket rollupBucket;
+			while (temperRollup.PopClosedBucket(rollupBucket))
+			{
+				batchContent->second.Add(std::string("TemperatureRollups\\") + rollupLevelNames[rollupBucket.level] + "\\" +
+					temperValues->Name(rollupBucket.handle),
+					std::to_string(rollupBucket.startTimestamp),
+					PCTemperaturesScanner::FormatRollupBucket(rollupBucket));
+			}
+
+			//closed quantile sketches
+			temperQuantiles.AppendSnapshot(*temperValues);
+			temperQuantiles.CloseExpired(PCTemperaturesScanner::SensorTimestampNow());
+			PCTemperaturesScanner::SensorQuantileWindow quantileWindow;
+			while (temperQuantiles.PopClosedWindow(quantileWindow))
+			{
+				batchContent->second.Add(std::string("TemperatureQuantiles\\") + temperValues->Name(quantileWindow.handle),
+					std::to_string(quantileWindow.startTimestamp),
+					quantileWindow.sketch.Serialize());
+			}
+
+			uploadBatch.values.insert(batchContent->second.values.begin(), batchContent->second.values.end());
+
+			if (!uploadBatch.Empty())
+			{
+				//failed batch: its content to next batch (over limit closed elements are dropped in path order, oldest of sensor first)
+				auto onBatchFailed = [&failedUploads, maxFailedElements](uploadContent& content)
+				{
+					std::lock_guard<std::mutex> retryLock(failedUploads.retryMutex);
+					failedUploads.deadbandHandles.insert(failedUploads.deadbandHandles.end(), content.first.begin(), content.first.end());
+					failedUploads.closedElements.values.merge(content.second.values);
+					while (failedUploads.closedElements.Size() > maxFailedElements)
+					{
+						failedUploads.closedElements.values.erase(failedUploads.closedElements.values.begin());
+					}
+				};
+				testFlag = false;
+				if (!testAdapter.SetElementsValues(uploadBatch, [&testFlag, batchContent, onBatchFailed](bool res)
+				{
+					if (!res)
+					{
+						onBatchFailed(*batchContent);
+					}
+					testFlag = true;
+				}))
+				{
+					std::cout << "testAdapter: SetElementsValues fail." << std::endl;
+					onBatchFailed(*batchContent);
+				}
 			}
 		}
 
-		std::this_thread::sleep_for(std::chrono::seconds(2));
+		//till next expected data of any source
+		std::this_thread::sleep_until(temperScanner.GetNextPollTime());
 
 		//inputStr = exit...
 	}
 
+	temperHistoryFile.Flush();
 	testAdapter.DisconnectFromFirebase();
 
 	system("pause");
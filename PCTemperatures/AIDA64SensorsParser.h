@@ -0,0 +1,233 @@
+//*********************************************************************************************************//
+//AIDA64SensorsParser header file
+//Single pass tokenizer for AIDA64 shared memory sensors block (without regex and copies)
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <string_view>
+#include <charconv>
+#include <system_error>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <vector>
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//one AIDA64 sensor element: <category><id>...</id><label>...</label><value>...</value></category>
+	//all fields are views of parsed buffer
+	struct AIDA64SensorItem
+	{
+		std::string_view category = {};
+		std::string_view id = {};
+		std::string_view label = {};
+		std::string_view value = {};
+	};
+
+	//parse AIDA64 value text to number
+	inline bool ParseAIDA64Value(std::string_view valueText, double& value)
+	{
+		const char* textEnd = valueText.data() + valueText.size();
+		std::from_chars_result convRes = std::from_chars(valueText.data(), textEnd, value);
+		return convRes.ec == std::errc() && convRes.ptr == textEnd;
+	}
+
+	//fast hash of sensors block text (8 bytes per step), for unchanged content check
+	inline uint64_t HashAIDA64Block(std::string_view data)
+	{
+		uint64_t blockHash = 14695981039346656037ULL ^ static_cast<uint64_t>(data.size());
+		size_t pos = 0;
+		for (; pos + sizeof(uint64_t) <= data.size(); pos += sizeof(uint64_t))
+		{
+			uint64_t dataWord = 0;
+			std::memcpy(&dataWord, data.data() + pos, sizeof(dataWord));
+			blockHash = (blockHash ^ dataWord) * 1099511628211ULL;
+			blockHash ^= blockHash >> 29;
+		}
+		for (; pos < data.size(); pos++)
+		{
+			blockHash = (blockHash ^ static_cast<unsigned char>(data[pos])) * 1099511628211ULL;
+		}
+		return blockHash;
+	}
+
+	//value text span in sensors block
+	struct AIDA64ValueSpan
+	{
+		size_t offset = 0;
+		size_t length = 0;
+	};
+
+	//light pass over <value>...</value> spans only, onValue(const AIDA64ValueSpan& valueSpan)
+	//return false if value span is not closed
+	template <typename valueHandler>
+	bool ScanAIDA64Values(std::string_view data, valueHandler&& onValue)
+	{
+		constexpr std::string_view valueOpenTag = "<value>";
+		constexpr std::string_view valueCloseTag = "</value>";
+		size_t pos = 0;
+		while (true)
+		{
+			size_t valueStart = data.find(valueOpenTag, pos);
+			if (valueStart == std::string_view::npos)
+			{
+				return true;
+			}
+			valueStart += valueOpenTag.size();
+			size_t valueEnd = data.find(valueCloseTag, valueStart);
+			if (valueEnd == std::string_view::npos)
+			{
+				return false;
+			}
+			onValue(AIDA64ValueSpan{ valueStart, valueEnd - valueStart });
+			pos = valueEnd;
+		}
+	}
+
+	//re-read value spans at cached offsets, work is proportional to number of values (not block size)
+	//value text width may change - next spans are shifted, valueSpans and blockSize are moved to new layout
+	//layout check: every span is still between <value> and </value>, block ends (null char) at shifted end
+	//data - buffer of dataCapacity bytes (block is null terminated if shorter)
+	//onValue(size_t spanIndex, std::string_view valueText), return false if layout changed
+	template <typename valueHandler>
+	bool RereadAIDA64Values(const char* data, size_t dataCapacity, std::vector<AIDA64ValueSpan>& valueSpans,
+		size_t& blockSize, valueHandler&& onValue)
+	{
+		constexpr std::string_view valueOpenTag = "<value>";
+		constexpr std::string_view valueCloseTag = "</value>";
+		//sum of value width changes before current span
+		ptrdiff_t offsetShift = 0;
+		for (size_t spanIndex = 0; spanIndex < valueSpans.size(); spanIndex++)
+		{
+			AIDA64ValueSpan& valueSpan = valueSpans[spanIndex];
+			size_t valueStart = static_cast<size_t>(static_cast<ptrdiff_t>(valueSpan.offset) + offsetShift);
+			if (valueStart < valueOpenTag.size() || valueStart >= dataCapacity ||
+				std::memcmp(data + valueStart - valueOpenTag.size(), valueOpenTag.data(), valueOpenTag.size()) != 0)
+			{
+				return false;
+			}
+			//value text is short, its end is near
+			const char* valueEnd = static_cast<const char*>(std::memchr(data + valueStart, '<', dataCapacity - valueStart));
+			if (valueEnd == nullptr ||
+				static_cast<size_t>(data + dataCapacity - valueEnd) < valueCloseTag.size() ||
+				std::memcmp(valueEnd, valueCloseTag.data(), valueCloseTag.size()) != 0)
+			{
+				return false;
+			}
+			size_t valueLength = static_cast<size_t>(valueEnd - (data + valueStart));
+			onValue(spanIndex, std::string_view(data + valueStart, valueLength));
+			offsetShift += static_cast<ptrdiff_t>(valueLength) - static_cast<ptrdiff_t>(valueSpan.length);
+			valueSpan.offset = valueStart;
+			valueSpan.length = valueLength;
+		}
+		//text after last span has same size: block ends with close tag at shifted end
+		size_t newBlockSize = static_cast<size_t>(static_cast<ptrdiff_t>(blockSize) + offsetShift);
+		if (newBlockSize == 0 || newBlockSize > dataCapacity || data[newBlockSize - 1] != '>' ||
+			(newBlockSize < dataCapacity && data[newBlockSize] != '\0'))
+		{
+			return false;
+		}
+		blockSize = newBlockSize;
+		return true;
+	}
+
+	//single pass over buffer, onItem(const AIDA64SensorItem&) called for every sensor element
+	//return false if buffer is malformed (items before error are already passed to onItem)
+	template <typename itemHandler>
+	bool ParseAIDA64Sensors(std::string_view data, itemHandler&& onItem)
+	{
+		//skip whitespaces between tags
+		auto skipSpaces = [&data](size_t& pos)
+		{
+			while (pos < data.size() && (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n'))
+			{
+				pos++;
+			}
+		};
+		//read tag at pos ('<' expected), return tag name and move pos after '>'
+		auto readTag = [&data, &skipSpaces](size_t& pos, std::string_view& tagName) -> bool
+		{
+			skipSpaces(pos);
+			if (pos >= data.size() || data[pos] != '<')
+			{
+				return false;
+			}
+			size_t tagEnd = data.find('>', pos + 1);
+			if (tagEnd == std::string_view::npos)
+			{
+				return false;
+			}
+			tagName = data.substr(pos + 1, tagEnd - pos - 1);
+			pos = tagEnd + 1;
+			return !tagName.empty();
+		};
+
+		size_t pos = 0;
+		std::string_view tagName = {};
+		AIDA64SensorItem item;
+		while (true)
+		{
+			//end of data
+			skipSpaces(pos);
+			if (pos >= data.size())
+			{
+				break;
+			}
+			//sensor element open tag
+			if (!readTag(pos, item.category) || item.category[0] == '/')
+			{
+				return false;
+			}
+			item.id = {};
+			item.label = {};
+			item.value = {};
+
+			//fields: <name>text</name> till element close tag
+			while (true)
+			{
+				if (!readTag(pos, tagName))
+				{
+					return false;
+				}
+				if (tagName[0] == '/')
+				{
+					if (tagName.substr(1) != item.category)
+					{
+						return false;
+					}
+					break;
+				}
+				size_t textStart = pos;
+				size_t textEnd = data.find('<', textStart);
+				if (textEnd == std::string_view::npos)
+				{
+					return false;
+				}
+				std::string_view fieldName = tagName;
+				pos = textEnd;
+				if (!readTag(pos, tagName) || tagName[0] != '/' || tagName.substr(1) != fieldName)
+				{
+					return false;
+				}
+				std::string_view fieldText = data.substr(textStart, textEnd - textStart);
+				if (fieldName == "value")
+				{
+					item.value = fieldText;
+				}
+				else if (fieldName == "label")
+				{
+					item.label = fieldText;
+				}
+				else if (fieldName == "id")
+				{
+					item.id = fieldText;
+				}
+			}
+			onItem(item);
+		}
+		return true;
+	}
+}
@@ -9,20 +9,93 @@
 
 #include <map>
 #include <vector>
+#include <algorithm>
+#include <array>
 #include <string>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <cwchar>
+#include <cstdint>
+#include <atomic>
+#include <thread>
 #include <iostream>
-#include <regex>
-#include <windows.h>
+#include <string_view>
+#include "SharedMemoryView.h"
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+#include "AIDA64SensorsParser.h"
 
 /* separate namespace */
 namespace PCTemperaturesScanner
 {
+#ifndef _WIN32
+	//Win32 types used by shared memory layouts of data sources
+	typedef wchar_t WCHAR;
+	typedef uint32_t UINT32;
+	typedef int32_t LONG;
+#endif
+
+	//convert wide string (null terminated or maxLen) to multibyte string
+	inline std::string WideToNarrow(const WCHAR* wideStr, size_t maxLen)
+	{
+		size_t wideLen = 0;
+		while (wideLen < maxLen && wideStr[wideLen] != 0)
+		{
+			wideLen++;
+		}
+		if (wideLen == 0)
+		{
+			return "";
+		}
+#ifdef _WIN32
+		int charLen = WideCharToMultiByte(CP_ACP, 0, wideStr, static_cast<int>(wideLen), NULL, 0, NULL, NULL);
+		std::string narrowStr(static_cast<size_t>(charLen > 0 ? charLen : 0), '\0');
+		if (charLen > 0)
+		{
+			WideCharToMultiByte(CP_ACP, 0, wideStr, static_cast<int>(wideLen), &narrowStr[0], charLen, NULL, NULL);
+		}
+		return narrowStr;
+#else
+		//synthetic sources - ASCII names
+		std::string narrowStr(wideLen, '?');
+		for (size_t i = 0; i < wideLen; i++)
+		{
+			if (wideStr[i] > 0 && wideStr[i] < 0x80)
+			{
+				narrowStr[i] = static_cast<char>(wideStr[i]);
+			}
+		}
+		return narrowStr;
+#endif
+	}
+
 	/* main class (base) */
 	class PCTemperaturesData
 	{
 	protected:
-		//pair: sensor name and value
-		std::map<std::string, double> temperSensorsData = {};
+		//sensors: name -> handle on discovery, values by handle
+		SensorTable sensorsTable;
+		//immutable snapshots of sensors table for readers
+		SensorSnapshotPublisher snapshotPublisher;
+		//producer update period reported by source (msec, 0 - unknown), for poll scheduling
+		int64_t sourcePeriodHint = 0;
+		//failed attaches to source in a row (absent source is polled repeatedly)
+		unsigned attachFailures = 0;
+		//attach error message: first failure and every ATTACH_FAILURE_MESSAGE_PERIOD failures
+		static constexpr unsigned ATTACH_FAILURE_MESSAGE_PERIOD = 100;
+
+		//count failed attach, true - message should be shown
+		bool attachFailureMessageDue()
+		{
+			return attachFailures++ % ATTACH_FAILURE_MESSAGE_PERIOD == 0;
+		}
+
+		//call after sensors table update - make new samples visible to snapshot readers
+		void publishSnapshot()
+		{
+			snapshotPublisher.Publish(sensorsTable);
+		}
 
 	private:
 		//dummy for debug messages output
@@ -47,27 +120,110 @@ namespace PCTemperaturesScanner
 		//copy array with sensors data to target
 		bool GetTemperatures(std::map<std::string, double>& data)
 		{
-			if (temperSensorsData.size())
+			if (sensorsTable.ActiveCount())
 			{
-				data = temperSensorsData;
+				data.clear();
+				for (size_t i = 0; i < sensorsTable.Size(); i++)
+				{
+					SensorHandle handle = static_cast<SensorHandle>(i);
+					if (sensorsTable.HasValue(handle))
+					{
+						data[sensorsTable.Name(handle)] = sensorsTable.Value(handle);
+					}
+				}
 				return true;
 			}
 			return false;
 		}
 
+		//copy typed records of active sensors to target
+		virtual bool GetSensorRecords(std::vector<SensorRecord>& records)
+		{
+			records.resize(sensorsTable.ActiveCount());
+			size_t recIdx = 0;
+			for (size_t i = 0; i < sensorsTable.Size() && recIdx < records.size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if ((sensorsTable.Flags(handle) & SENSOR_FLAG_ACTIVE) != 0)
+				{
+					records[recIdx] = sensorsTable.Info(handle);
+					records[recIdx].value = sensorsTable.Value(handle);
+					recIdx++;
+				}
+			}
+			return !records.empty();
+		}
+
+		//latest published samples of all sensors, no copy of data
+		//snapshot stays valid and unchanged while reference exists
+		//safe to call from any thread while UpdateTemperatures works (lock-free)
+		SensorSnapshotRef GetSnapshot() const
+		{
+			return snapshotPublisher.GetCurrent();
+		}
+
+		//producer update period from source own timestamps, msec (0 - source has no timestamps)
+		//new data detection itself - by snapshot Generation()
+		int64_t GetSourcePeriodHint() const
+		{
+			return sourcePeriodHint;
+		}
+
+		//sensors table for linear scans and handle based access
+		const SensorTable& GetSensorsTable() const
+		{
+			return sensorsTable;
+		}
+
+		//find sensor handle by his name (discovery time), INVALID_SENSOR_HANDLE if not found
+		SensorHandle FindSensorHandle(const std::string& key) const
+		{
+			return sensorsTable.Find(key);
+		}
+
 		//find and return sensor data by his name
-		bool GetTemperValByKey(std::string& key, double& val)
+		bool GetTemperValByKey(const std::string& key, double& val)
+		{
+			return GetTemperValByHandle(sensorsTable.Find(key), val);
+		}
+
+		//return sensor data by handle, O(1)
+		bool GetTemperValByHandle(SensorHandle handle, double& val) const
 		{
-			std::map<std::string, double>::iterator findedEl = temperSensorsData.find(key);
-			if (findedEl != temperSensorsData.end())
+			if (sensorsTable.HasValue(handle))
 			{
-				val = findedEl->second;
+				val = sensorsTable.Value(handle);
 				return true;
 			}
 			return false;
 		}
 	};
 
+	//GPUZ shared memory access mode
+	enum class GPUZAttachMode
+	{
+		GPUZ_ATTACH_PER_POLL = 0,	//open, map, copy and close on every poll
+		GPUZ_ATTACH_PERSISTENT		//attach once, keep view mapped, re-attach when producer goes away
+	};
+
+	//GPUZ shared memory copy mode
+	enum class GPUZCopyMode
+	{
+		GPUZ_COPY_FULL_BLOCK = 0,	//copy and parse whole block on every update
+		GPUZ_COPY_TRACKED_VALUES	//read record table and names on layout change, per poll gather only tracked values
+	};
+
+	//GPUZ reader statistics
+	struct GPUZReadStats
+	{
+		uint64_t pollsTotal = 0;	//UpdateTemperatures calls
+		uint64_t pollsSkipped = 0;	//lastUpdate not advanced - no copy and no parse
+		uint64_t readRetries = 0;	//busy flag set or block updated during copy
+		uint64_t readsFailed = 0;	//no consistent copy after all retries
+		uint64_t layoutScans = 0;	//full block copies (record table and sensor names)
+		uint64_t indexRebuilds = 0;	//sensor slot index rebuilds (names table changed)
+	};
+
 	/* GPUZ reader */
 	/* get temperatures data from GPUZ */
 	class GPUZTemperatures : public PCTemperaturesData
@@ -100,171 +256,716 @@ namespace PCTemperaturesScanner
 		};
 #pragma pack(pop)
 
+		//GPUZ shared memory name
+		static constexpr const char* GPUZ_SH_MEM_NAME = "GPUZShMem";
+		//max attempts to get consistent copy while producer is busy
+		static constexpr int GPUZ_READ_MAX_ATTEMPTS = 64;
+
+		//tracked sensor: slot in GPUZ_SH_MEM::sensors, cached on layout scan
+		struct GPUZTrackedSlot
+		{
+			int slot = 0;
+			//interned sensor
+			SensorHandle handle = INVALID_SENSOR_HANDLE;
+		};
+
+		//shared memory view (kept mapped between polls in persistent mode)
+		SharedMemoryView gpuzShMem;
+		//preallocated snapshot buffer for full shared memory copy
+		std::unique_ptr<GPUZ_SH_MEM> gpuData = std::make_unique<GPUZ_SH_MEM>();
+		//shared memory access and copy modes
+		GPUZAttachMode attachMode = GPUZAttachMode::GPUZ_ATTACH_PERSISTENT;
+		GPUZCopyMode copyMode = GPUZCopyMode::GPUZ_COPY_TRACKED_VALUES;
+		//sensors layout: version, tracked slots and dense array of their values
+		bool layoutValid = false;
+		UINT32 layoutVersion = 0;
+		std::vector<GPUZTrackedSlot> trackedSlots = {};
+		std::vector<double> trackedValues = {};
+		//full name hashes of all slots for layout change check
+		std::array<uint64_t, GPUZ_RECORDS_COUNT> slotNameHashes = {};
+		//all slots name check period (in updates), finds sensors appeared in free slots
+		int layoutRescanPeriod = 60;
+		int updatesSinceLayoutScan = 0;
+		//included sensor kinds (SensorKindMask bits)
+		unsigned sensorKindFilter = SensorKindMask(SensorKind::SENSOR_KIND_TEMPERATURE);
+		//lastUpdate of parsed data
+		UINT32 snapshotUpdate = 0;
+		//last seen GPUZ_SH_MEM::lastUpdate and local time when it changed
+		UINT32 lastSeenUpdate = 0;
+		std::chrono::steady_clock::time_point lastSeenUpdateTime = {};
+		//if producer data not changed during this time - view is re-attached
+		std::chrono::milliseconds reattachTimeout = std::chrono::milliseconds(10000);
+		//read statistics
+		GPUZReadStats readStats = {};
+
 		void DebugMessage(std::string msgText) override
 		{
 			std::cout << "GPUZTemperatures::UpdateTemperatures: " << msgText << std::endl;
 		}
 
+		//FNV-1a hash of whole sensor name
+		static uint64_t getNameHash(const GPUZ_SENSOR_RECORD& sensor)
+		{
+			uint64_t nameHash = 14695981039346656037ULL;
+			for (int i = 0; i < 256 && sensor.name[i] != 0; i++)
+			{
+				nameHash = (nameHash ^ static_cast<uint64_t>(sensor.name[i])) * 1099511628211ULL;
+			}
+			return nameHash;
+		}
+
+		//seqlock-style copy of shared memory to snapshot buffer:
+		//wait while busy flag set, copy, then check that busy and lastUpdate not changed during copy
+		bool readConsistentSnapshot(const volatile GPUZ_SH_MEM* shMem)
+		{
+			for (int attempt = 0; attempt < GPUZ_READ_MAX_ATTEMPTS; attempt++)
+			{
+				if (attempt)
+				{
+					readStats.readRetries++;
+					std::this_thread::yield();
+				}
+				//producer is writing
+				if (shMem->busy)
+				{
+					continue;
+				}
+				UINT32 updateBefore = shMem->lastUpdate;
+				std::atomic_thread_fence(std::memory_order_acquire);
+				std::memcpy(gpuData.get(), const_cast<const GPUZ_SH_MEM*>(shMem), sizeof(GPUZ_SH_MEM));
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (!shMem->busy && shMem->lastUpdate == updateBefore)
+				{
+					snapshotUpdate = updateBefore;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//full block copy, rebuild tracked slots index if names changed and take values from snapshot
+		bool scanLayout(const volatile GPUZ_SH_MEM* shMem)
+		{
+			if (!readConsistentSnapshot(shMem))
+			{
+				return false;
+			}
+			readStats.layoutScans++;
+
+			//same names table - index is actual
+			bool namesChanged = !layoutValid || gpuData->version != layoutVersion;
+			for (int i = 0; i < GPUZ_RECORDS_COUNT; i++)
+			{
+				uint64_t nameHash = getNameHash(gpuData->sensors[i]);
+				if (nameHash != slotNameHashes[i])
+				{
+					slotNameHashes[i] = nameHash;
+					namesChanged = true;
+				}
+			}
+			if (namesChanged)
+			{
+				rebuildSlotIndex();
+			}
+			for (size_t i = 0; i < trackedSlots.size(); i++)
+			{
+				trackedValues[i] = gpuData->sensors[trackedSlots[i].slot].value;
+			}
+
+			layoutVersion = gpuData->version;
+			layoutValid = true;
+			updatesSinceLayoutScan = 0;
+			return true;
+		}
+
+		//sensor kind by GPUZ name and unit
+		static SensorKind getSensorKind(const GPUZ_SENSOR_RECORD& sensor)
+		{
+			if (wcsstr(sensor.name, L"Temperature") != nullptr)
+			{
+				return SensorKind::SENSOR_KIND_TEMPERATURE;
+			}
+			if (wcsstr(sensor.name, L"Fan") != nullptr)
+			{
+				return SensorKind::SENSOR_KIND_FAN;
+			}
+			if (wcscmp(sensor.unit, L"MHz") == 0 || wcscmp(sensor.unit, L"GHz") == 0)
+			{
+				return SensorKind::SENSOR_KIND_CLOCK;
+			}
+			if (wcscmp(sensor.unit, L"%") == 0)
+			{
+				return SensorKind::SENSOR_KIND_LOAD;
+			}
+			if (wcscmp(sensor.unit, L"RPM") == 0)
+			{
+				return SensorKind::SENSOR_KIND_FAN;
+			}
+			if (wcscmp(sensor.unit, L"W") == 0)
+			{
+				return SensorKind::SENSOR_KIND_POWER;
+			}
+			if (wcscmp(sensor.unit, L"V") == 0)
+			{
+				return SensorKind::SENSOR_KIND_VOLTAGE;
+			}
+			if (wcscmp(sensor.unit, L"A") == 0)
+			{
+				return SensorKind::SENSOR_KIND_CURRENT;
+			}
+			if (sensor.unit[0] == 0xB0)
+			{
+				//degree sign
+				return SensorKind::SENSOR_KIND_TEMPERATURE;
+			}
+			return SensorKind::SENSOR_KIND_OTHER;
+		}
+
+		//build slot -> sensor index from snapshot names, only place with string work
+		void rebuildSlotIndex()
+		{
+			readStats.indexRebuilds++;
+
+			std::vector<GPUZTrackedSlot> newSlots;
+			for (int i = 0; i < GPUZ_RECORDS_COUNT; i++)
+			{
+				const GPUZ_SENSOR_RECORD& sensor = gpuData->sensors[i];
+				if (sensor.name[0] == 0)
+				{
+					continue;
+				}
+				SensorKind sensorKind = getSensorKind(sensor);
+				if ((sensorKindFilter & SensorKindMask(sensorKind)) != 0)
+				{
+					//intern sensor
+					std::string sensorName = WideToNarrow(sensor.name, 256);
+					GPUZTrackedSlot trackedSlot;
+					trackedSlot.slot = i;
+					trackedSlot.handle = sensorsTable.Register(sensorName);
+					sensorsTable.SetInfo(trackedSlot.handle, sensorName, sensorKind,
+						WideToNarrow(sensor.unit, 8), static_cast<int>(sensor.digits));
+					newSlots.push_back(trackedSlot);
+				}
+			}
+			//remove sensors which are not present anymore
+			for (const GPUZTrackedSlot& oldSlot : trackedSlots)
+			{
+				if (std::none_of(newSlots.begin(), newSlots.end(),
+					[&oldSlot](const GPUZTrackedSlot& newSlot) { return newSlot.handle == oldSlot.handle; }))
+				{
+					sensorsTable.Deactivate(oldSlot.handle);
+				}
+			}
+			trackedSlots = std::move(newSlots);
+			trackedValues.resize(trackedSlots.size());
+		}
+
+		//seqlock-style gather of tracked sensors values only
+		//return false if layout changed (version or names) or no consistent read
+		//checkAllSlots - compare name hashes of all slots, not only tracked
+		bool gatherTrackedValues(const volatile GPUZ_SH_MEM* shMem, bool checkAllSlots, bool& layoutChanged)
+		{
+			layoutChanged = false;
+			for (int attempt = 0; attempt < GPUZ_READ_MAX_ATTEMPTS; attempt++)
+			{
+				if (attempt)
+				{
+					readStats.readRetries++;
+					std::this_thread::yield();
+				}
+				if (shMem->busy)
+				{
+					continue;
+				}
+				UINT32 updateBefore = shMem->lastUpdate;
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (shMem->version != layoutVersion)
+				{
+					layoutChanged = true;
+					return false;
+				}
+				const GPUZ_SENSOR_RECORD* sensors = const_cast<const GPUZ_SENSOR_RECORD*>(shMem->sensors);
+				if (checkAllSlots)
+				{
+					for (int i = 0; i < GPUZ_RECORDS_COUNT; i++)
+					{
+						if (getNameHash(sensors[i]) != slotNameHashes[i])
+						{
+							layoutChanged = true;
+							return false;
+						}
+					}
+				}
+				for (size_t i = 0; i < trackedSlots.size(); i++)
+				{
+					const GPUZ_SENSOR_RECORD& sensor = sensors[trackedSlots[i].slot];
+					if (getNameHash(sensor) != slotNameHashes[trackedSlots[i].slot])
+					{
+						layoutChanged = true;
+						return false;
+					}
+					std::memcpy(&trackedValues[i], &sensor.value, sizeof(double));
+				}
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (!shMem->busy && shMem->lastUpdate == updateBefore)
+				{
+					snapshotUpdate = updateBefore;
+					return true;
+				}
+			}
+			return false;
+		}
+
 	public:
-		GPUZTemperatures()
+		GPUZTemperatures(GPUZAttachMode mode = GPUZAttachMode::GPUZ_ATTACH_PERSISTENT) : attachMode(mode)
 		{
 		}
 		~GPUZTemperatures()
 		{
 		}
 
-		//get data from GPUZ throught shared memory
-		bool UpdateTemperatures() override
+		//change shared memory access mode, current view is closed
+		void SetAttachMode(GPUZAttachMode mode)
+		{
+			attachMode = mode;
+			gpuzShMem.Close();
+		}
+
+		//change shared memory copy mode, layout is rescanned on next update
+		void SetCopyMode(GPUZCopyMode mode)
 		{
-			HANDLE hMapFile;
-			LPCTSTR pBuf;
+			copyMode = mode;
+			layoutValid = false;
+		}
 
-			hMapFile = OpenFileMapping(
-				FILE_MAP_ALL_ACCESS, // read/write access
-				FALSE, // do not inherit the name
-				L"GPUZShMem"); // name of mapping object
+		//set period (in updates) of all slots names check in tracked values mode
+		void SetLayoutRescanPeriod(int updatesCount)
+		{
+			layoutRescanPeriod = updatesCount > 0 ? updatesCount : 1;
+		}
+
+		//set included sensor kinds (SensorKindMask bits), index is rebuilt on next update
+		void SetSensorKindFilter(unsigned kindMask)
+		{
+			sensorKindFilter = kindMask;
+			layoutValid = false;
+		}
+
+		//set producer inactivity time for re-attach in persistent mode
+		void SetReattachTimeout(std::chrono::milliseconds timeout)
+		{
+			reattachTimeout = timeout;
+		}
+
+		//get reader statistics (skipped polls, retries)
+		const GPUZReadStats& GetReadStats() const
+		{
+			return readStats;
+		}
+		void ResetReadStats()
+		{
+			readStats = {};
+		}
 
-			if (hMapFile == NULL)
+		//copy GPU static info (GPUZ record table, read on layout scan) to target
+		bool GetGPUInfo(std::map<std::string, std::string>& info)
+		{
+			if (!layoutValid)
 			{
-				DebugMessage("Could not open file mapping object (" + std::to_string(static_cast<int>(GetLastError())) + ")");
 				return false;
 			}
+			info.clear();
+			for (int i = 0; i < GPUZ_RECORDS_COUNT; i++)
+			{
+				if (gpuData->data[i].key[0] != 0)
+				{
+					info[WideToNarrow(gpuData->data[i].key, 256)] = WideToNarrow(gpuData->data[i].value, 256);
+				}
+			}
+			return true;
+		}
 
-			pBuf = (LPTSTR)MapViewOfFile(hMapFile, // handle to map object
-				FILE_MAP_ALL_ACCESS, // read/write permission
-				0,
-				0,
-				sizeof(GPUZ_SH_MEM));
+		//get data from GPUZ throught shared memory
+		bool UpdateTemperatures() override
+		{
+			readStats.pollsTotal++;
 
-			if (pBuf == NULL)
+			//attach to shared memory (every poll or once in persistent mode)
+			if (!gpuzShMem.IsOpen())
 			{
-				DebugMessage("Could not map view of file (" + std::to_string(static_cast<int>(GetLastError())) + ")");
-				CloseHandle(hMapFile);
-				return false;
+				if (!gpuzShMem.Open(GPUZ_SH_MEM_NAME, sizeof(GPUZ_SH_MEM), true))
+				{
+					if (attachFailureMessageDue())
+					{
+						DebugMessage("Could not open shared memory view (" + std::to_string(gpuzShMem.LastError()) +
+							"), failed attempts: " + std::to_string(attachFailures));
+					}
+					return false;
+				}
+				attachFailures = 0;
+				lastSeenUpdateTime = std::chrono::steady_clock::now();
 			}
 
-			std::unique_ptr<GPUZ_SH_MEM> gpuData = std::make_unique<GPUZ_SH_MEM>();
-			if (!gpuData)
+			//read shared memory only if producer published new data
+			const volatile GPUZ_SH_MEM* shMem = static_cast<const volatile GPUZ_SH_MEM*>(gpuzShMem.Data());
+			UINT32 updateStamp = shMem->lastUpdate;
+			bool dataChanged = !layoutValid || updateStamp != snapshotUpdate;
+			UINT32 prevSnapshotUpdate = snapshotUpdate;
+			bool prevLayoutValid = layoutValid;
+			bool readRes = true;
+			if (dataChanged)
 			{
-				DebugMessage("No memory for read data stream.");
+				bool layoutChanged = false;
+				if (copyMode == GPUZCopyMode::GPUZ_COPY_FULL_BLOCK || !layoutValid)
+				{
+					readRes = scanLayout(shMem);
+				}
+				else
+				{
+					bool checkAllSlots = ++updatesSinceLayoutScan >= layoutRescanPeriod;
+					if (checkAllSlots)
+					{
+						updatesSinceLayoutScan = 0;
+					}
+					if (!gatherTrackedValues(shMem, checkAllSlots, layoutChanged))
+					{
+						readRes = layoutChanged && scanLayout(shMem);
+					}
+				}
+			}
 
-				UnmapViewOfFile(pBuf);
-				CloseHandle(hMapFile);
+			if (attachMode == GPUZAttachMode::GPUZ_ATTACH_PER_POLL)
+			{
+				//close acces to shared memory
+				gpuzShMem.Close();
+			}
+			else
+			{
+				//persistent view keeps object alive after producer exit - check producer activity
+				std::chrono::steady_clock::time_point timeNow = std::chrono::steady_clock::now();
+				if (updateStamp != lastSeenUpdate)
+				{
+					lastSeenUpdate = updateStamp;
+					lastSeenUpdateTime = timeNow;
+				}
+				else if (timeNow - lastSeenUpdateTime > reattachTimeout)
+				{
+					//re-attach on next poll
+					DebugMessage("Producer data not updated, re-attach to shared memory");
+					gpuzShMem.Close();
+				}
+			}
 
+			//nothing new - sensors data is actual
+			if (!dataChanged)
+			{
+				readStats.pollsSkipped++;
+				return true;
+			}
+			if (!readRes)
+			{
+				readStats.readsFailed++;
+				layoutValid = false;
+				DebugMessage("Could not get consistent copy of shared memory (producer busy)");
 				return false;
 			}
 
-			//copy shared memory to buffer
-			CopyMemory(gpuData.get(), pBuf, sizeof(GPUZ_SH_MEM));
-			//and close acces to shared memory
-			UnmapViewOfFile(pBuf);
-			CloseHandle(hMapFile);
+			//producer period (GetTickCount() difference, can be several periods if polls were rare)
+			if (prevLayoutValid && snapshotUpdate != prevSnapshotUpdate)
+			{
+				sourcePeriodHint = static_cast<int64_t>(static_cast<UINT32>(snapshotUpdate - prevSnapshotUpdate));
+			}
 
-			//parse buffer to array of sensors and data
-			for (int i = 0; i < GPUZ_RECORDS_COUNT; i++)
+			//tracked values to interned sensors
+			int64_t sampleTimestamp = SensorTimestampNow();
+			for (size_t i = 0; i < trackedSlots.size(); i++)
 			{
-				if (wcsstr(gpuData->sensors[i].name, L"Temperature") != nullptr)
-				{
-					std::vector<char> charBuf(256);
-					WideCharToMultiByte(CP_ACP, 0, gpuData->sensors[i].name, -1, &charBuf[0], 256, NULL, NULL);
-					temperSensorsData[std::string(charBuf.begin(), charBuf.end())] = gpuData->sensors[i].value;
-				}
+				sensorsTable.SetValue(trackedSlots[i].handle, trackedValues[i], sampleTimestamp);
 			}
+			publishSnapshot();
 
 			return true;
 		}
 	};
 
+	//AIDA64 reader statistics
+	struct AIDA64ReadStats
+	{
+		uint64_t pollsTotal = 0;		//UpdateTemperatures calls
+		uint64_t pollsSkipped = 0;		//value spans not changed - no update
+		uint64_t incrementalUpdates = 0;	//only value spans re-read
+		uint64_t fullParses = 0;		//whole block parsed (first poll, layout change, periodic check)
+		uint64_t reattaches = 0;		//view re-opened after producer inactivity
+	};
+
 	/* AIDA64 reader */
 	/* get temperatures data from AIDA64 */
 	class AIDA64Temperatures : public PCTemperaturesData
 	{
 	private:
 
-		//static const std::wstring SharedMemName = L"AIDA64_SensorValues";
+		//AIDA64 shared memory name
+		static constexpr const char* AIDA64_SH_MEM_NAME = "AIDA64_SensorValues";
+
+		//sensor value span cached on full parse
+		struct AIDA64CachedValue
+		{
+			//index of <value> span in block
+			size_t spanIndex = 0;
+			//interned sensor, key - AIDA64 <id>
+			SensorHandle handle = INVALID_SENSOR_HANDLE;
+			//value read by incremental update, applied if layout not changed
+			double value = 0.0;
+		};
+
+		//shared memory view, kept mapped between polls
+		SharedMemoryView aidaShMem;
+		//layout of last parse: all value spans (numeric and text) and block size, moved by value width changes
+		bool layoutValid = false;
+		std::vector<AIDA64ValueSpan> valueSpans = {};
+		size_t blockSize = 0;
+		std::vector<AIDA64CachedValue> cachedValues = {};
+		//hash of last read value texts
+		uint64_t valuesHash = 0;
+		//full parse period (in polls), catches id and label changes of same layout
+		int fullParsePeriod = 60;
+		int pollsSinceFullParse = 0;
+		//local time of last block change
+		std::chrono::steady_clock::time_point lastChangeTime = {};
+		//if block not changed during this time - view is re-attached (AIDA64 updates sys time every second)
+		std::chrono::milliseconds reattachTimeout = std::chrono::milliseconds(10000);
+		//included sensor kinds (SensorKindMask bits)
+		unsigned sensorKindFilter = SENSOR_KIND_MASK_ALL;
+		//read statistics
+		AIDA64ReadStats readStats = {};
 
 		void DebugMessage(std::string msgText) override
 		{
 			std::cout << "AIDA64Temperatures::UpdateTemperatures: " << msgText << std::endl;
 		}
 
-	public:
-		AIDA64Temperatures()
-		{
-		}
-		~AIDA64Temperatures()
+		//sensor kind and unit by AIDA64 category, return false for unknown category
+		static bool getCategoryKind(std::string_view category, SensorKind& kind, const char*& unit)
 		{
+			struct AIDA64Category
+			{
+				std::string_view tag;
+				SensorKind kind;
+				const char* unit;
+			};
+			static constexpr AIDA64Category categories[] =
+			{
+				{"sys", SensorKind::SENSOR_KIND_OTHER, ""},
+				{"temp", SensorKind::SENSOR_KIND_TEMPERATURE, "\xB0" "C"},
+				{"fan", SensorKind::SENSOR_KIND_FAN, "RPM"},
+				{"duty", SensorKind::SENSOR_KIND_FAN, "%"},
+				{"volt", SensorKind::SENSOR_KIND_VOLTAGE, "V"},
+				{"curr", SensorKind::SENSOR_KIND_CURRENT, "A"},
+				{"pwr", SensorKind::SENSOR_KIND_POWER, "W"}
+			};
+			for (const AIDA64Category& aidaCategory : categories)
+			{
+				if (aidaCategory.tag == category)
+				{
+					kind = aidaCategory.kind;
+					unit = aidaCategory.unit;
+					return true;
+				}
+			}
+			return false;
 		}
 
-		//get data from AIDA64 throught shared memory
-		bool UpdateTemperatures() override
+		//parse whole block and cache value spans
+		bool fullParse(std::string_view sensorsData)
 		{
-			HANDLE hMapFile;
-			LPCSTR pBuf;
+			readStats.fullParses++;
 
-			hMapFile = OpenFileMapping(
-				FILE_MAP_READ, // read access
-				FALSE, // do not inherit the name
-				L"AIDA64_SensorValues"); // name of mapping object
+			std::vector<AIDA64CachedValue> newValues;
+			std::vector<size_t> valueOffsets;
+			int64_t sampleTimestamp = SensorTimestampNow();
+			bool parseRes = ParseAIDA64Sensors(sensorsData, [&](const AIDA64SensorItem& item)
+			{
+				SensorKind sensorKind = SensorKind::SENSOR_KIND_OTHER;
+				const char* sensorUnit = "";
+				double sensorValue = 0.0;
+				//known category, numeric value (sys also has date/time strings)
+				if (!item.id.empty() &&
+					getCategoryKind(item.category, sensorKind, sensorUnit) &&
+					(sensorKindFilter & SensorKindMask(sensorKind)) != 0 &&
+					ParseAIDA64Value(item.value, sensorValue))
+				{
+					//intern sensor and set value
+					AIDA64CachedValue cachedValue;
+					cachedValue.handle = sensorsTable.Register(std::string(item.id));
+					sensorsTable.SetInfo(cachedValue.handle, std::string(item.label), sensorKind, sensorUnit, 0);
+					sensorsTable.SetValue(cachedValue.handle, sensorValue, sampleTimestamp);
+					newValues.push_back(cachedValue);
+					valueOffsets.push_back(static_cast<size_t>(item.value.data() - sensorsData.data()));
+				}
+			});
+			//remove sensors which are not present anymore
+			for (const AIDA64CachedValue& oldValue : cachedValues)
+			{
+				if (std::none_of(newValues.begin(), newValues.end(),
+					[&oldValue](const AIDA64CachedValue& newValue) { return newValue.handle == oldValue.handle; }))
+				{
+					sensorsTable.Deactivate(oldValue.handle);
+				}
+			}
+
+			//value spans for incremental updates
+			size_t nextValue = 0;
+			valueSpans.clear();
+			valuesHash = 14695981039346656037ULL;
+			bool scanRes = ScanAIDA64Values(sensorsData, [&](const AIDA64ValueSpan& valueSpan)
+			{
+				if (nextValue < newValues.size() && valueSpan.offset == valueOffsets[nextValue])
+				{
+					newValues[nextValue++].spanIndex = valueSpans.size();
+				}
+				valuesHash = (valuesHash ^ HashAIDA64Block(sensorsData.substr(valueSpan.offset, valueSpan.length))) * 1099511628211ULL;
+				valueSpans.push_back(valueSpan);
+			});
+			cachedValues = std::move(newValues);
+			blockSize = sensorsData.size();
+			pollsSinceFullParse = 0;
+
+			layoutValid = parseRes && scanRes && nextValue == cachedValues.size();
+			return parseRes;
+		}
 
-			if (hMapFile == NULL)
+		//re-read only cached value spans (value text width may change), return false if layout changed
+		//dataChanged - false if no value text changed since last read
+		bool updateCachedValues(const char* pBuf, size_t bufSize, bool& dataChanged)
+		{
+			size_t nextValue = 0;
+			bool valuesRes = true;
+			uint64_t blockValuesHash = 14695981039346656037ULL;
+			bool rereadRes = RereadAIDA64Values(pBuf, bufSize, valueSpans, blockSize, [&](size_t spanIndex, std::string_view valueText)
+			{
+				blockValuesHash = (blockValuesHash ^ HashAIDA64Block(valueText)) * 1099511628211ULL;
+				if (nextValue < cachedValues.size() && cachedValues[nextValue].spanIndex == spanIndex)
+				{
+					valuesRes = ParseAIDA64Value(valueText, cachedValues[nextValue++].value) && valuesRes;
+				}
+			});
+			if (!rereadRes || !valuesRes || nextValue != cachedValues.size())
 			{
-				DebugMessage("Could not open file mapping object (" + std::to_string(static_cast<int>(GetLastError())) + ")");
 				return false;
 			}
+			dataChanged = blockValuesHash != valuesHash;
+			valuesHash = blockValuesHash;
+			if (!dataChanged)
+			{
+				//nothing changed
+				readStats.pollsSkipped++;
+				return true;
+			}
+			int64_t sampleTimestamp = SensorTimestampNow();
+			for (const AIDA64CachedValue& cachedValue : cachedValues)
+			{
+				sensorsTable.SetValue(cachedValue.handle, cachedValue.value, sampleTimestamp);
+			}
+			readStats.incrementalUpdates++;
+			return true;
+		}
 
-			pBuf = (LPSTR)MapViewOfFile(hMapFile, // handle to map object
-				FILE_MAP_READ, // read permission
-				0,
-				0,
-				0);
+	public:
+		AIDA64Temperatures()
+		{
+		}
+		~AIDA64Temperatures()
+		{
+		}
 
-			if (pBuf == NULL)
-			{
-				DebugMessage("Could not map view of file (" + std::to_string(static_cast<int>(GetLastError())) + ")");
+		//set included sensor kinds (SensorKindMask bits), block is fully parsed on next update
+		void SetSensorKindFilter(unsigned kindMask)
+		{
+			sensorKindFilter = kindMask;
+			layoutValid = false;
+		}
 
-				CloseHandle(hMapFile);
+		//set full parse period (in polls), block layout is checked only near value spans between full parses
+		void SetFullParsePeriod(int pollsCount)
+		{
+			fullParsePeriod = pollsCount > 0 ? pollsCount : 1;
+		}
 
-				return false;
-			}
+		//set producer inactivity time for re-attach
+		void SetReattachTimeout(std::chrono::milliseconds timeout)
+		{
+			reattachTimeout = timeout;
+		}
 
-			//create std::string with info from shared memory
-			std::string sensorsData(pBuf);
-			//and close access to shared memory
-			UnmapViewOfFile(pBuf);
-			CloseHandle(hMapFile);
+		//get reader statistics (skipped polls, incremental updates)
+		const AIDA64ReadStats& GetReadStats() const
+		{
+			return readStats;
+		}
+		void ResetReadStats()
+		{
+			readStats = {};
+		}
 
-			/* parsing variant with using regex */
-			auto parseAIDA64Str = [this](std::string& sensStr)
+		//get data from AIDA64 throught shared memory
+		bool UpdateTemperatures() override
+		{
+			readStats.pollsTotal++;
+
+			//AIDA64 shared memory - null terminated string, map whole object once
+			if (!aidaShMem.IsOpen())
 			{
-				auto getDataStrByRegex = [](const std::string& str, const std::regex& regExpr)->std::string
+				if (!aidaShMem.Open(AIDA64_SH_MEM_NAME, 0))
 				{
-					std::smatch regexMatch;
-					if (std::regex_search(str, regexMatch, regExpr))
+					if (attachFailureMessageDue())
 					{
-						return regexMatch[1];
+						DebugMessage("Could not open shared memory view (" + std::to_string(aidaShMem.LastError()) +
+							"), failed attempts: " + std::to_string(attachFailures));
 					}
-					else
-					{
-						return "";
-					}
-				};
-				std::regex regexTemp("<temp>(.*?)<\/temp>");
-				std::smatch regTempMatch;
-				std::string::const_iterator sensStrStart(sensStr.cbegin());
-				while (std::regex_search(sensStrStart, sensStr.cend(), regTempMatch, regexTemp))
-				{
-					this->temperSensorsData[
-						getDataStrByRegex(regTempMatch[1], std::regex("<label>(.*?)<\/label>"))
-					] = std::stod(getDataStrByRegex(regTempMatch[1], std::regex("<value>(.*?)<\/value>")));
-						sensStrStart = regTempMatch.suffix().first;
+					return false;
 				}
-			};
+				attachFailures = 0;
+				lastChangeTime = std::chrono::steady_clock::now();
+			}
 
-			//parsing
-			parseAIDA64Str(sensorsData);
+			//read shared memory block in place: cached value spans or whole block on layout change
+			const char* pBuf = static_cast<const char*>(aidaShMem.Data());
+			bool parseRes = true;
+			bool dataChanged = true;
+			if (!layoutValid || ++pollsSinceFullParse >= fullParsePeriod ||
+				!updateCachedValues(pBuf, aidaShMem.Size(), dataChanged))
+			{
+				bool prevLayoutValid = layoutValid;
+				uint64_t prevValuesHash = valuesHash;
+				parseRes = fullParse(std::string_view(pBuf, strnlen(pBuf, aidaShMem.Size())));
+				//periodic full parse of same values is not a change
+				dataChanged = !prevLayoutValid || valuesHash != prevValuesHash;
+			}
 
-			return false;
+			//view keeps object alive after producer exit (or re-create) - check producer activity
+			std::chrono::steady_clock::time_point timeNow = std::chrono::steady_clock::now();
+			if (dataChanged)
+			{
+				lastChangeTime = timeNow;
+			}
+			else if (timeNow - lastChangeTime > reattachTimeout)
+			{
+				//re-attach on next poll
+				DebugMessage("Producer data not updated, re-attach to shared memory");
+				readStats.reattaches++;
+				aidaShMem.Close();
+			}
+
+			if (!parseRes)
+			{
+				DebugMessage("Sensors data format error");
+				return false;
+			}
+			if (dataChanged)
+			{
+				publishSnapshot();
+			}
+			return true;
 		}
 	};
-}
\ No newline at end of file
+}
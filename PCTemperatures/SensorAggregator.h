@@ -0,0 +1,483 @@
+//*********************************************************************************************************//
+//SensorAggregator header file
+//Registry of sensors data providers and aggregator polling them concurrently on worker pool
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include "PCTemperaturesScanner.h"
+#include "SensorPollScheduler.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	/* providers registry: source tag -> factory */
+	class SensorProviderRegistry
+	{
+	public:
+		using ProviderFactory = std::function<std::unique_ptr<PCTemperaturesData>()>;
+
+	private:
+		std::map<std::string, ProviderFactory> factories = {};
+
+	public:
+		SensorProviderRegistry()
+		{
+		}
+		~SensorProviderRegistry()
+		{
+		}
+
+		//registry with built-in providers: "GPUZ", "AIDA64"
+		static SensorProviderRegistry CreateDefault()
+		{
+			SensorProviderRegistry registry;
+			registry.Register("GPUZ", []() { return std::make_unique<GPUZTemperatures>(); });
+			registry.Register("AIDA64", []() { return std::make_unique<AIDA64Temperatures>(); });
+			return registry;
+		}
+
+		//add or replace provider factory
+		void Register(const std::string& sourceTag, ProviderFactory factory)
+		{
+			factories[sourceTag] = std::move(factory);
+		}
+
+		//new provider object, nullptr if tag not registered
+		std::unique_ptr<PCTemperaturesData> Create(const std::string& sourceTag) const
+		{
+			std::map<std::string, ProviderFactory>::const_iterator findedEl = factories.find(sourceTag);
+			return findedEl != factories.end() ? findedEl->second() : nullptr;
+		}
+
+		//all registered tags
+		std::vector<std::string> Tags() const
+		{
+			std::vector<std::string> tags;
+			for (const std::pair<const std::string, ProviderFactory>& factory : factories)
+			{
+				tags.push_back(factory.first);
+			}
+			return tags;
+		}
+	};
+
+	/* fixed worker threads with tasks queue */
+	class SensorWorkerPool
+	{
+	private:
+		std::vector<std::thread> workers = {};
+		std::deque<std::function<void()>> tasks = {};
+		std::mutex tasksMutex;
+		std::condition_variable tasksCondition;
+		bool stopWorkers = false;
+
+		void workerProcess()
+		{
+			while (true)
+			{
+				std::unique_lock<std::mutex> tasksLock(tasksMutex);
+				tasksCondition.wait(tasksLock, [this]() { return stopWorkers || !tasks.empty(); });
+				if (tasks.empty())
+				{
+					//stop
+					return;
+				}
+				std::function<void()> task = std::move(tasks.front());
+				tasks.pop_front();
+				tasksLock.unlock();
+				task();
+			}
+		}
+
+	public:
+		explicit SensorWorkerPool(size_t workersCount)
+		{
+			workersCount = workersCount > 0 ? workersCount : 1;
+			for (size_t i = 0; i < workersCount; i++)
+			{
+				workers.emplace_back([this]() { workerProcess(); });
+			}
+		}
+		~SensorWorkerPool()
+		{
+			std::unique_lock<std::mutex> tasksLock(tasksMutex);
+			stopWorkers = true;
+			tasksLock.unlock();
+			tasksCondition.notify_all();
+			//queued tasks are finished before exit
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+		}
+		SensorWorkerPool(const SensorWorkerPool&) = delete;
+		SensorWorkerPool& operator=(const SensorWorkerPool&) = delete;
+
+		void Submit(std::function<void()> task)
+		{
+			std::unique_lock<std::mutex> tasksLock(tasksMutex);
+			tasks.push_back(std::move(task));
+			tasksLock.unlock();
+			tasksCondition.notify_one();
+		}
+
+		size_t WorkersCount() const
+		{
+			return workers.size();
+		}
+	};
+
+	//provider poll statistics
+	struct SensorProviderStats
+	{
+		uint64_t pollsTotal = 0;		//polls started
+		uint64_t pollsFailed = 0;		//UpdateTemperatures returned false (e.g. source not running)
+		uint64_t pollsLate = 0;			//poll not finished before aggregator timeout
+		uint64_t pollsSkipped = 0;		//previous poll still running
+	};
+
+	/* aggregator - provider of merged sensors set */
+	/* UpdateTemperatures polls all providers concurrently and waits for slowest (or timeout), */
+	/* then merges latest snapshots of providers: sensor key = "<source tag>:<provider key>", SensorRecord::source = tag */
+	/* late provider keeps running in background, its last snapshot is used and next poll is skipped */
+	/* provider without new snapshot for stale timeout (source exited) - its sensors are deactivated till next snapshot */
+	class SensorAggregator : public PCTemperaturesData
+	{
+	private:
+		struct ProviderEntry
+		{
+			size_t index = 0;
+			std::string sourceTag;
+			std::unique_ptr<PCTemperaturesData> provider;
+			//poll is running on worker
+			std::atomic<bool> pollActive = false;
+			//running poll is counted as late already
+			bool pollLate = false;
+			bool lastPollResult = false;
+			SensorProviderStats stats;
+			//snapshot generation after last poll (worker side), change = new data from producer
+			uint64_t polledGeneration = 0;
+			//last merged snapshot: publish and info generations
+			uint64_t mergedGeneration = 0;
+			uint64_t mergedInfoGeneration = 0;
+			//time of last merged new snapshot, sensors are deactivated when it is older than stale timeout
+			SensorPollScheduler::Clock::time_point mergedTime = {};
+			bool stale = false;
+			//provider handle -> aggregated handle
+			std::vector<SensorHandle> handles;
+		};
+
+		std::vector<std::unique_ptr<ProviderEntry>> providers = {};
+		std::unique_ptr<SensorWorkerPool> workerPool = nullptr;
+		size_t workersCount = 0;
+		//wait limit for one poll
+		std::chrono::milliseconds pollTimeout = std::chrono::milliseconds(1000);
+		//providers poll results/stats, end of poll is signaled by pollCondition
+		mutable std::mutex pollMutex;
+		std::condition_variable pollCondition;
+		//providers polled by current update
+		std::vector<ProviderEntry*> startedPolls = {};
+		//adaptive polling: only providers due by scheduler are polled
+		bool adaptivePolling = false;
+		SensorPollScheduler pollScheduler;
+		//provider without new snapshot for this time is stale (source exited, reader keeps last snapshot)
+		std::chrono::milliseconds staleTimeout = std::chrono::milliseconds(30000);
+		//fixed polling: period of updates and start of last update
+		std::chrono::milliseconds pollInterval = std::chrono::milliseconds(2000);
+		SensorPollScheduler::Clock::time_point lastUpdateTime = {};
+
+		void DebugMessage(std::string msgText) override
+		{
+			std::cout << "SensorAggregator::UpdateTemperatures: " << msgText << std::endl;
+		}
+
+		//copy provider snapshot to aggregated table, return true if something changed
+		bool mergeProvider(ProviderEntry& entry, SensorPollScheduler::Clock::time_point timeNow)
+		{
+			SensorSnapshotRef snapshot = entry.provider->GetSnapshot();
+			if (!snapshot || snapshot->Generation() == entry.mergedGeneration)
+			{
+				return expireProvider(entry, timeNow);
+			}
+			//new sensors or metadata - resolve handles
+			if (snapshot->InfoGeneration() != entry.mergedInfoGeneration || entry.handles.size() != snapshot->Size())
+			{
+				entry.handles.resize(snapshot->Size(), INVALID_SENSOR_HANDLE);
+				for (size_t i = 0; i < snapshot->Size(); i++)
+				{
+					SensorHandle handle = static_cast<SensorHandle>(i);
+					const SensorRecord& info = snapshot->Info(handle);
+					if (entry.handles[i] == INVALID_SENSOR_HANDLE)
+					{
+						entry.handles[i] = sensorsTable.Register(entry.sourceTag + ":" + info.name);
+					}
+					sensorsTable.SetInfo(entry.handles[i], info.label, info.kind, info.unit, info.digits);
+					sensorsTable.SetSource(entry.handles[i], entry.sourceTag);
+				}
+				entry.mergedInfoGeneration = snapshot->InfoGeneration();
+			}
+			for (size_t i = 0; i < snapshot->Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (snapshot->HasValue(handle))
+				{
+					//re-activate after provider restart
+					if ((sensorsTable.Flags(entry.handles[i]) & SENSOR_FLAG_ACTIVE) == 0)
+					{
+						sensorsTable.Register(sensorsTable.Name(entry.handles[i]));
+					}
+					sensorsTable.SetValue(entry.handles[i], snapshot->Value(handle), snapshot->Timestamp(handle));
+				}
+				else if ((snapshot->Flags(handle) & SENSOR_FLAG_ACTIVE) == 0)
+				{
+					sensorsTable.Deactivate(entry.handles[i]);
+				}
+			}
+			entry.mergedGeneration = snapshot->Generation();
+			entry.mergedTime = timeNow;
+			entry.stale = false;
+			return true;
+		}
+
+		//deactivate sensors of provider without new snapshot for stale timeout (re-activated by next snapshot)
+		//return true if something changed
+		bool expireProvider(ProviderEntry& entry, SensorPollScheduler::Clock::time_point timeNow)
+		{
+			if (entry.stale || entry.mergedGeneration == 0 || timeNow - entry.mergedTime < staleTimeout)
+			{
+				return false;
+			}
+			for (SensorHandle handle : entry.handles)
+			{
+				if (handle != INVALID_SENSOR_HANDLE)
+				{
+					sensorsTable.Deactivate(handle);
+				}
+			}
+			entry.stale = true;
+			DebugMessage("No new data from " + entry.sourceTag + ", its sensors are deactivated");
+			return true;
+		}
+
+	public:
+		//workers - poll threads count (0 - one per provider, created on first update)
+		explicit SensorAggregator(size_t workers = 0) : workersCount(workers)
+		{
+		}
+		~SensorAggregator()
+		{
+			//wait running polls (provider objects are used by workers)
+			workerPool.reset();
+		}
+
+		//add provider (before first update), sourceTag - prefix of sensors keys
+		bool AddProvider(const std::string& sourceTag, std::unique_ptr<PCTemperaturesData> provider)
+		{
+			if (provider == nullptr || sourceTag.empty() || workerPool != nullptr)
+			{
+				return false;
+			}
+			std::unique_ptr<ProviderEntry> entry = std::make_unique<ProviderEntry>();
+			entry->index = providers.size();
+			entry->sourceTag = sourceTag;
+			entry->provider = std::move(provider);
+			providers.push_back(std::move(entry));
+			pollScheduler.Resize(providers.size());
+			return true;
+		}
+
+		//add all providers of registry
+		void AddProviders(const SensorProviderRegistry& registry)
+		{
+			for (const std::string& sourceTag : registry.Tags())
+			{
+				AddProvider(sourceTag, registry.Create(sourceTag));
+			}
+		}
+
+		//poll wait limit, late provider does not delay others
+		void SetPollTimeout(std::chrono::milliseconds timeout)
+		{
+			pollTimeout = timeout;
+		}
+
+		//poll every provider only when its producer is expected to publish new data (see SensorPollScheduler)
+		//caller should call UpdateTemperatures at GetNextPollTime()
+		void SetAdaptivePolling(bool enable)
+		{
+			adaptivePolling = enable;
+		}
+
+		//scheduler settings (before first update)
+		SensorPollScheduler& GetPollScheduler()
+		{
+			return pollScheduler;
+		}
+
+		//provider sensors are deactivated if it has no new snapshot for this time
+		void SetStaleTimeout(std::chrono::milliseconds timeout)
+		{
+			staleTimeout = timeout;
+		}
+
+		//period of updates if adaptive polling disabled
+		void SetPollInterval(std::chrono::milliseconds interval)
+		{
+			pollInterval = interval;
+		}
+
+		//nearest poll time of adaptive polling (last update + poll interval - if adaptive polling disabled)
+		SensorPollScheduler::Clock::time_point GetNextPollTime() const
+		{
+			std::lock_guard<std::mutex> pollLock(pollMutex);
+			if (!adaptivePolling)
+			{
+				return lastUpdateTime + pollInterval;
+			}
+			return pollScheduler.GetNextPollTime();
+		}
+
+		//learned period, staleness and wasted polls of provider
+		SensorPollStats GetPollStats(size_t index) const
+		{
+			std::lock_guard<std::mutex> pollLock(pollMutex);
+			return pollScheduler.GetStats(index);
+		}
+
+		size_t ProvidersCount() const
+		{
+			return providers.size();
+		}
+
+		const std::string& GetProviderTag(size_t index) const
+		{
+			return providers[index]->sourceTag;
+		}
+
+		//provider object (e.g. for reader settings), do not use while aggregator update works
+		PCTemperaturesData* GetProvider(size_t index) const
+		{
+			return providers[index]->provider.get();
+		}
+
+		//result of last finished poll of provider
+		bool GetProviderPollResult(size_t index) const
+		{
+			std::lock_guard<std::mutex> pollLock(pollMutex);
+			return providers[index]->lastPollResult;
+		}
+
+		SensorProviderStats GetProviderStats(size_t index) const
+		{
+			std::lock_guard<std::mutex> pollLock(pollMutex);
+			return providers[index]->stats;
+		}
+
+		//poll all providers concurrently and merge results
+		bool UpdateTemperatures() override
+		{
+			if (providers.empty())
+			{
+				return false;
+			}
+			if (workerPool == nullptr)
+			{
+				workerPool = std::make_unique<SensorWorkerPool>(workersCount > 0 ? workersCount : providers.size());
+			}
+
+			//start polls
+			std::unique_lock<std::mutex> pollLock(pollMutex);
+			SensorPollScheduler::Clock::time_point timeNow = SensorPollScheduler::Clock::now();
+			lastUpdateTime = timeNow;
+			startedPolls.clear();
+			for (std::unique_ptr<ProviderEntry>& entry : providers)
+			{
+				if (adaptivePolling && !pollScheduler.IsDue(entry->index, timeNow))
+				{
+					continue;
+				}
+				if (entry->pollActive.load(std::memory_order_acquire))
+				{
+					entry->stats.pollsSkipped++;
+					continue;
+				}
+				entry->pollActive.store(true, std::memory_order_relaxed);
+				entry->pollLate = false;
+				entry->stats.pollsTotal++;
+				ProviderEntry* entryPtr = entry.get();
+				startedPolls.push_back(entryPtr);
+				workerPool->Submit([this, entryPtr]()
+				{
+					SensorPollScheduler::Clock::time_point pollTime = SensorPollScheduler::Clock::now();
+					bool pollRes = entryPtr->provider->UpdateTemperatures();
+					SensorSnapshotRef snapshot = entryPtr->provider->GetSnapshot();
+					uint64_t generation = snapshot ? snapshot->Generation() : 0;
+					bool newData = generation != entryPtr->polledGeneration;
+					entryPtr->polledGeneration = generation;
+					std::unique_lock<std::mutex> workerLock(pollMutex);
+					entryPtr->lastPollResult = pollRes;
+					if (!pollRes)
+					{
+						entryPtr->stats.pollsFailed++;
+					}
+					pollScheduler.OnPoll(entryPtr->index, pollTime, newData, entryPtr->provider->GetSourcePeriodHint());
+					entryPtr->pollActive.store(false, std::memory_order_release);
+					workerLock.unlock();
+					pollCondition.notify_all();
+				});
+			}
+
+			//wait slowest provider of this update (polls still running from previous updates are not waited)
+			auto startedPollsDone = [this]()
+			{
+				return std::none_of(startedPolls.begin(), startedPolls.end(),
+					[](const ProviderEntry* entry) { return entry->pollActive.load(std::memory_order_relaxed); });
+			};
+			if (!pollCondition.wait_for(pollLock, pollTimeout, startedPollsDone))
+			{
+				for (ProviderEntry* entry : startedPolls)
+				{
+					if (entry->pollActive.load(std::memory_order_relaxed) && !entry->pollLate)
+					{
+						entry->pollLate = true;
+						entry->stats.pollsLate++;
+					}
+				}
+				DebugMessage("Some providers did not finish poll in time");
+			}
+			bool anyPollOk = false;
+			for (std::unique_ptr<ProviderEntry>& entry : providers)
+			{
+				anyPollOk = anyPollOk || entry->lastPollResult;
+			}
+			pollLock.unlock();
+
+			//merge latest snapshots (lock-free, late providers too)
+			bool dataChanged = false;
+			timeNow = SensorPollScheduler::Clock::now();
+			for (std::unique_ptr<ProviderEntry>& entry : providers)
+			{
+				dataChanged = mergeProvider(*entry, timeNow) || dataChanged;
+			}
+			if (dataChanged)
+			{
+				publishSnapshot();
+			}
+			return anyPollOk;
+		}
+	};
+}
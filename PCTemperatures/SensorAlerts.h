@@ -0,0 +1,225 @@
+//*********************************************************************************************************//
+//SensorAlerts header file
+//Incremental alert rules engine: thresholds with hysteresis, minimum duration and rate of change
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//condition of rule
+	enum class SensorAlertType
+	{
+		//value > threshold, cleared when value < threshold - hysteresis
+		ALERT_VALUE_ABOVE = 0,
+		//value < threshold, cleared when value > threshold + hysteresis
+		ALERT_VALUE_BELOW,
+		//rate of change (units per second) > threshold, cleared when rate < threshold - hysteresis
+		ALERT_RATE_ABOVE
+	};
+
+	//alert rule for one sensor
+	struct SensorAlertRule
+	{
+		//rule name (key for alert message)
+		std::string name = "";
+		//sensor key (SensorRecord::name)
+		std::string sensorName = "";
+		SensorAlertType type = SensorAlertType::ALERT_VALUE_ABOVE;
+		double threshold = 0.0;
+		double hysteresis = 0.0;
+		//condition must hold this time before alert is raised, msec
+		int64_t minDuration = 0;
+	};
+
+	//alert state change
+	struct SensorAlertEvent
+	{
+		//index of rule (returned by AddRule)
+		int ruleId = -1;
+		SensorHandle handle = INVALID_SENSOR_HANDLE;
+		//true - alert raised, false - cleared
+		bool raised = false;
+		int64_t timestamp = 0;
+		//sensor value
+		double value = 0.0;
+		//value checked by rule: sensor value, rate of change (units per second) for ALERT_RATE_ABOVE
+		double ruleValue = 0.0;
+	};
+
+	/* alert rules engine */
+	/* rules are bound to sensor handles on first sample of sensor (sensor -> rules index), */
+	/* every new sample is checked only by rules of its sensor */
+	class SensorAlerts
+	{
+	private:
+		//rule with evaluation state
+		struct RuleState
+		{
+			SensorAlertRule rule;
+			bool active = false;
+			//start of condition (waiting for min duration)
+			bool conditionHolds = false;
+			int64_t conditionSince = 0;
+		};
+		//sample state of sensor for rate rules
+		struct SensorState
+		{
+			//rules index was built for this rules generation
+			uint64_t rulesGeneration = 0;
+			std::vector<int> rules;
+			bool hasSample = false;
+			int64_t lastTimestamp = 0;
+			double lastValue = 0.0;
+		};
+
+		std::vector<RuleState> rules = {};
+		//sensor name -> rules
+		std::unordered_map<std::string, std::vector<int>> rulesByName = {};
+		//incremented on every rule add, sensors rules index is rebuilt on next sample
+		uint64_t rulesGeneration = 1;
+		std::vector<SensorState> sensors = {};
+
+		//condition values of rule: raise and clear
+		static void checkRule(const SensorAlertRule& rule, double metric, bool& raiseCond, bool& clearCond)
+		{
+			switch (rule.type)
+			{
+				case SensorAlertType::ALERT_VALUE_BELOW:
+					raiseCond = metric < rule.threshold;
+					clearCond = metric > rule.threshold + rule.hysteresis;
+				break;
+
+				case SensorAlertType::ALERT_VALUE_ABOVE:
+				case SensorAlertType::ALERT_RATE_ABOVE:
+				default:
+					raiseCond = metric > rule.threshold;
+					clearCond = metric < rule.threshold - rule.hysteresis;
+				break;
+			}
+		}
+
+	public:
+		SensorAlerts()
+		{
+		}
+		~SensorAlerts()
+		{
+		}
+
+		//add rule, return rule id
+		int AddRule(const SensorAlertRule& rule)
+		{
+			int ruleId = static_cast<int>(rules.size());
+			rules.push_back({ .rule = rule });
+			rulesByName[rule.sensorName].push_back(ruleId);
+			rulesGeneration++;
+			return ruleId;
+		}
+
+		//check new sample of sensor by its rules, onEvent(const SensorAlertEvent&) for raised and cleared alerts
+		//sensorName is used only to bind rules on first sample (or after rules change)
+		template <typename eventHandler>
+		void Evaluate(SensorHandle handle, const std::string& sensorName, int64_t timestamp, double value, eventHandler&& onEvent)
+		{
+			if (handle < 0)
+			{
+				return;
+			}
+			if (static_cast<size_t>(handle) >= sensors.size())
+			{
+				sensors.resize(static_cast<size_t>(handle) + 1);
+			}
+			SensorState& sensor = sensors[handle];
+			if (sensor.rulesGeneration != rulesGeneration)
+			{
+				std::unordered_map<std::string, std::vector<int>>::const_iterator findedEl = rulesByName.find(sensorName);
+				sensor.rules = findedEl != rulesByName.end() ? findedEl->second : std::vector<int>();
+				sensor.rulesGeneration = rulesGeneration;
+			}
+
+			//rate of change, units per second
+			bool hasRate = sensor.hasSample && timestamp > sensor.lastTimestamp;
+			double rate = hasRate ? (value - sensor.lastValue) * 1000.0 / static_cast<double>(timestamp - sensor.lastTimestamp) : 0.0;
+			sensor.hasSample = true;
+			sensor.lastTimestamp = timestamp;
+			sensor.lastValue = value;
+
+			for (int ruleId : sensor.rules)
+			{
+				RuleState& state = rules[ruleId];
+				bool isRateRule = state.rule.type == SensorAlertType::ALERT_RATE_ABOVE;
+				if (isRateRule && !hasRate)
+				{
+					continue;
+				}
+				bool raiseCond = false, clearCond = false;
+				double ruleValue = isRateRule ? rate : value;
+				checkRule(state.rule, ruleValue, raiseCond, clearCond);
+				if (!state.active)
+				{
+					if (!raiseCond)
+					{
+						state.conditionHolds = false;
+						continue;
+					}
+					if (!state.conditionHolds)
+					{
+						state.conditionHolds = true;
+						state.conditionSince = timestamp;
+					}
+					if (timestamp - state.conditionSince >= state.rule.minDuration)
+					{
+						state.active = true;
+						onEvent(SensorAlertEvent{ .ruleId = ruleId, .handle = handle, .raised = true, .timestamp = timestamp, .value = value, .ruleValue = ruleValue });
+					}
+				}
+				else if (clearCond)
+				{
+					state.active = false;
+					state.conditionHolds = false;
+					onEvent(SensorAlertEvent{ .ruleId = ruleId, .handle = handle, .raised = false, .timestamp = timestamp, .value = value, .ruleValue = ruleValue });
+				}
+			}
+		}
+
+		//check samples of snapshot which are newer than last checked
+		template <typename eventHandler>
+		void EvaluateSnapshot(const SensorSnapshot& snapshot, eventHandler&& onEvent)
+		{
+			for (size_t i = 0; i < snapshot.Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (snapshot.HasValue(handle) &&
+					(i >= sensors.size() || !sensors[i].hasSample || snapshot.Timestamp(handle) > sensors[i].lastTimestamp))
+				{
+					Evaluate(handle, snapshot.Name(handle), snapshot.Timestamp(handle), snapshot.Value(handle), onEvent);
+				}
+			}
+		}
+
+		const SensorAlertRule& GetRule(int ruleId) const
+		{
+			return rules[ruleId].rule;
+		}
+
+		bool IsActive(int ruleId) const
+		{
+			return rules[ruleId].active;
+		}
+
+		size_t RulesCount() const
+		{
+			return rules.size();
+		}
+	};
+}
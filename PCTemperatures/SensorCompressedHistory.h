@@ -0,0 +1,433 @@
+//*********************************************************************************************************//
+//SensorCompressedHistory header file
+//Compressed sensors history: Gorilla-style blocks (delta-of-delta timestamps, XOR-encoded values)
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <bit>
+#include <cstdint>
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//compressed samples of one sensor, bit stream in 64-bit words (most significant bit first)
+	struct SensorCompressedBlock
+	{
+		int64_t startTimestamp = 0;
+		int64_t endTimestamp = 0;
+		size_t count = 0;
+		size_t bitsCount = 0;
+		std::vector<uint64_t> words = {};
+
+		size_t SizeBytes() const
+		{
+			return (bitsCount + 7) / 8;
+		}
+	};
+
+	/* block encoder */
+	/* timestamp: first - 64 bits, next - delta of delta: '0' | '10'+7 | '110'+9 | '1110'+12 | '1111'+64 bits */
+	/* value: first - 64 bits, next - XOR with previous: '0' same value | '10' meaningful bits in previous window | */
+	/* '11' + 5 bits leading zeros + 6 bits length + meaningful bits */
+	class SensorBlockEncoder
+	{
+	private:
+		SensorCompressedBlock block = {};
+		int64_t prevDelta = 0;
+		uint64_t prevValueBits = 0;
+		//meaningful bits window of previous XOR, leading = 64 - no window
+		int prevLeading = 64;
+		int prevTrailing = 0;
+
+		void writeBits(uint64_t value, int bitsNum)
+		{
+			if (bitsNum <= 0)
+			{
+				return;
+			}
+			if (bitsNum < 64)
+			{
+				value &= (1ULL << bitsNum) - 1;
+			}
+			int bitPos = static_cast<int>(block.bitsCount % 64);
+			if (bitPos == 0)
+			{
+				block.words.push_back(0);
+			}
+			int freeBits = 64 - bitPos;
+			if (bitsNum <= freeBits)
+			{
+				block.words.back() |= value << (freeBits - bitsNum);
+			}
+			else
+			{
+				block.words.back() |= value >> (bitsNum - freeBits);
+				block.words.push_back(value << (64 - (bitsNum - freeBits)));
+			}
+			block.bitsCount += bitsNum;
+		}
+
+		void writeTimestamp(int64_t timestamp)
+		{
+			int64_t delta = timestamp - block.endTimestamp;
+			int64_t deltaOfDelta = delta - prevDelta;
+			prevDelta = delta;
+			if (deltaOfDelta == 0)
+			{
+				writeBits(0, 1);
+			}
+			else if (deltaOfDelta >= -63 && deltaOfDelta <= 64)
+			{
+				writeBits(0x2, 2);
+				writeBits(static_cast<uint64_t>(deltaOfDelta + 63), 7);
+			}
+			else if (deltaOfDelta >= -255 && deltaOfDelta <= 256)
+			{
+				writeBits(0x6, 3);
+				writeBits(static_cast<uint64_t>(deltaOfDelta + 255), 9);
+			}
+			else if (deltaOfDelta >= -2047 && deltaOfDelta <= 2048)
+			{
+				writeBits(0xE, 4);
+				writeBits(static_cast<uint64_t>(deltaOfDelta + 2047), 12);
+			}
+			else
+			{
+				writeBits(0xF, 4);
+				writeBits(static_cast<uint64_t>(deltaOfDelta), 64);
+			}
+		}
+
+		void writeValue(uint64_t valueBits)
+		{
+			uint64_t xorBits = valueBits ^ prevValueBits;
+			prevValueBits = valueBits;
+			if (xorBits == 0)
+			{
+				writeBits(0, 1);
+				return;
+			}
+			int leading = std::countl_zero(xorBits);
+			int trailing = std::countr_zero(xorBits);
+			//leading zeros count is stored in 5 bits
+			leading = leading > 31 ? 31 : leading;
+			if (prevLeading < 64 && leading >= prevLeading && trailing >= prevTrailing)
+			{
+				writeBits(0x2, 2);
+				writeBits(xorBits >> prevTrailing, 64 - prevLeading - prevTrailing);
+				return;
+			}
+			int meaningful = 64 - leading - trailing;
+			writeBits(0x3, 2);
+			writeBits(static_cast<uint64_t>(leading), 5);
+			//length 64 is stored as 0
+			writeBits(static_cast<uint64_t>(meaningful & 0x3F), 6);
+			writeBits(xorBits >> trailing, meaningful);
+			prevLeading = leading;
+			prevTrailing = trailing;
+		}
+
+	public:
+		SensorBlockEncoder()
+		{
+		}
+		~SensorBlockEncoder()
+		{
+		}
+
+		//add sample, timestamps must not decrease
+		void Append(int64_t timestamp, double value)
+		{
+			uint64_t valueBits = std::bit_cast<uint64_t>(value);
+			if (block.count == 0)
+			{
+				writeBits(static_cast<uint64_t>(timestamp), 64);
+				writeBits(valueBits, 64);
+				block.startTimestamp = timestamp;
+				prevValueBits = valueBits;
+			}
+			else
+			{
+				writeTimestamp(timestamp);
+				writeValue(valueBits);
+			}
+			block.endTimestamp = timestamp;
+			block.count++;
+		}
+
+		//block in progress (can be decoded)
+		const SensorCompressedBlock& Block() const
+		{
+			return block;
+		}
+
+		size_t Count() const
+		{
+			return block.count;
+		}
+
+		//finish block: move it to caller and start new one
+		SensorCompressedBlock Seal()
+		{
+			SensorCompressedBlock sealedBlock = std::move(block);
+			sealedBlock.words.shrink_to_fit();
+			block = {};
+			prevDelta = 0;
+			prevValueBits = 0;
+			prevLeading = 64;
+			prevTrailing = 0;
+			return sealedBlock;
+		}
+	};
+
+	/* block decoder, sequential read of all samples */
+	class SensorBlockDecoder
+	{
+	private:
+		const SensorCompressedBlock& block;
+		size_t bitPos = 0;
+		size_t samplesRead = 0;
+		int64_t timestamp = 0;
+		int64_t prevDelta = 0;
+		uint64_t valueBits = 0;
+		int prevLeading = 64;
+		int prevTrailing = 0;
+
+		uint64_t readBits(int bitsNum)
+		{
+			if (bitsNum <= 0)
+			{
+				return 0;
+			}
+			size_t wordIdx = bitPos / 64;
+			int bitOffset = static_cast<int>(bitPos % 64);
+			int availBits = 64 - bitOffset;
+			bitPos += bitsNum;
+			if (bitsNum <= availBits)
+			{
+				return (block.words[wordIdx] << bitOffset) >> (64 - bitsNum);
+			}
+			uint64_t highBits = block.words[wordIdx] & ((1ULL << availBits) - 1);
+			int lowBitsNum = bitsNum - availBits;
+			return (highBits << lowBitsNum) | (block.words[wordIdx + 1] >> (64 - lowBitsNum));
+		}
+
+		bool readBit()
+		{
+			return readBits(1) != 0;
+		}
+
+	public:
+		explicit SensorBlockDecoder(const SensorCompressedBlock& blockToRead) : block(blockToRead)
+		{
+		}
+		~SensorBlockDecoder()
+		{
+		}
+
+		//next sample, false - end of block
+		bool Next(int64_t& sampleTimestamp, double& sampleValue)
+		{
+			if (samplesRead >= block.count)
+			{
+				return false;
+			}
+			if (samplesRead == 0)
+			{
+				timestamp = static_cast<int64_t>(readBits(64));
+				valueBits = readBits(64);
+			}
+			else
+			{
+				//timestamp
+				int64_t deltaOfDelta = 0;
+				if (!readBit())
+				{
+					deltaOfDelta = 0;
+				}
+				else if (!readBit())
+				{
+					deltaOfDelta = static_cast<int64_t>(readBits(7)) - 63;
+				}
+				else if (!readBit())
+				{
+					deltaOfDelta = static_cast<int64_t>(readBits(9)) - 255;
+				}
+				else if (!readBit())
+				{
+					deltaOfDelta = static_cast<int64_t>(readBits(12)) - 2047;
+				}
+				else
+				{
+					deltaOfDelta = static_cast<int64_t>(readBits(64));
+				}
+				prevDelta += deltaOfDelta;
+				timestamp += prevDelta;
+
+				//value
+				if (readBit())
+				{
+					if (readBit())
+					{
+						prevLeading = static_cast<int>(readBits(5));
+						int meaningful = static_cast<int>(readBits(6));
+						meaningful = meaningful == 0 ? 64 : meaningful;
+						prevTrailing = 64 - prevLeading - meaningful;
+					}
+					valueBits ^= readBits(64 - prevLeading - prevTrailing) << prevTrailing;
+				}
+			}
+			samplesRead++;
+			sampleTimestamp = timestamp;
+			sampleValue = std::bit_cast<double>(valueBits);
+			return true;
+		}
+	};
+
+	/* compressed history of all sensors */
+	/* per sensor: block in progress and sealed blocks (oldest removed over retention limit) */
+	class SensorCompressedHistory
+	{
+	private:
+		struct SensorBlocks
+		{
+			SensorBlockEncoder encoder;
+			std::deque<SensorCompressedBlock> sealedBlocks;
+			int64_t lastTimestamp = 0;
+		};
+
+		//samples per block, sealed blocks per sensor
+		size_t blockSamples = 0;
+		size_t maxSealedBlocks = 0;
+		std::vector<SensorBlocks> sensors = {};
+		//totals of stored samples and compressed size (sealed and in progress blocks)
+		size_t samplesCount = 0;
+		size_t sealedBytes = 0;
+
+	public:
+		//samplesPerBlock - block is sealed after this number of samples
+		//maxBlocksPerSensor - retention in sealed blocks, 0 - no limit
+		SensorCompressedHistory(size_t samplesPerBlock, size_t maxBlocksPerSensor) :
+			blockSamples(samplesPerBlock > 0 ? samplesPerBlock : 1), maxSealedBlocks(maxBlocksPerSensor)
+		{
+		}
+		~SensorCompressedHistory()
+		{
+		}
+
+		//add sample of one sensor, timestamps must not decrease
+		void Append(SensorHandle handle, int64_t timestamp, double value)
+		{
+			if (handle < 0)
+			{
+				return;
+			}
+			if (static_cast<size_t>(handle) >= sensors.size())
+			{
+				sensors.resize(static_cast<size_t>(handle) + 1);
+			}
+			SensorBlocks& sensor = sensors[handle];
+			sensor.encoder.Append(timestamp, value);
+			sensor.lastTimestamp = timestamp;
+			samplesCount++;
+			if (sensor.encoder.Count() >= blockSamples)
+			{
+				sensor.sealedBlocks.push_back(sensor.encoder.Seal());
+				sealedBytes += sensor.sealedBlocks.back().SizeBytes();
+				if (maxSealedBlocks > 0 && sensor.sealedBlocks.size() > maxSealedBlocks)
+				{
+					samplesCount -= sensor.sealedBlocks.front().count;
+					sealedBytes -= sensor.sealedBlocks.front().SizeBytes();
+					sensor.sealedBlocks.pop_front();
+				}
+			}
+		}
+
+		//add samples of all sensors from snapshot which are newer than last appended
+		void AppendSnapshot(const SensorSnapshot& snapshot)
+		{
+			for (size_t i = 0; i < snapshot.Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (snapshot.HasValue(handle) &&
+					(i >= sensors.size() || sensors[i].encoder.Count() + sensors[i].sealedBlocks.size() == 0 ||
+						snapshot.Timestamp(handle) > sensors[i].lastTimestamp))
+				{
+					Append(handle, snapshot.Timestamp(handle), snapshot.Value(handle));
+				}
+			}
+		}
+
+		//decode samples of sensor in [fromTimestamp, toTimestamp], onSample(timestamp, value)
+		//blocks out of range are skipped without decoding
+		template <typename sampleHandler>
+		void ForEachSample(SensorHandle handle, int64_t fromTimestamp, int64_t toTimestamp, sampleHandler&& onSample) const
+		{
+			if (handle < 0 || static_cast<size_t>(handle) >= sensors.size())
+			{
+				return;
+			}
+			auto decodeBlock = [&](const SensorCompressedBlock& block)
+			{
+				if (block.count == 0 || block.endTimestamp < fromTimestamp || block.startTimestamp > toTimestamp)
+				{
+					return;
+				}
+				SensorBlockDecoder decoder(block);
+				int64_t timestamp = 0;
+				double value = 0.0;
+				while (decoder.Next(timestamp, value) && timestamp <= toTimestamp)
+				{
+					if (timestamp >= fromTimestamp)
+					{
+						onSample(timestamp, value);
+					}
+				}
+			};
+			const SensorBlocks& sensor = sensors[handle];
+			for (const SensorCompressedBlock& block : sensor.sealedBlocks)
+			{
+				decodeBlock(block);
+			}
+			decodeBlock(sensor.encoder.Block());
+		}
+
+		//sealed blocks of sensor (e.g. for upload or saving)
+		const std::deque<SensorCompressedBlock>* GetSealedBlocks(SensorHandle handle) const
+		{
+			if (handle < 0 || static_cast<size_t>(handle) >= sensors.size())
+			{
+				return nullptr;
+			}
+			return &sensors[handle].sealedBlocks;
+		}
+
+		//number of stored samples, all sensors
+		size_t SamplesCount() const
+		{
+			return samplesCount;
+		}
+
+		//compressed size, all sensors
+		size_t SizeBytes() const
+		{
+			size_t openBytes = 0;
+			for (const SensorBlocks& sensor : sensors)
+			{
+				openBytes += sensor.encoder.Block().SizeBytes();
+			}
+			return sealedBytes + openBytes;
+		}
+
+		double BytesPerSample() const
+		{
+			return samplesCount > 0 ? static_cast<double>(SizeBytes()) / static_cast<double>(samplesCount) : 0.0;
+		}
+	};
+}
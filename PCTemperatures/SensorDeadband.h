@@ -0,0 +1,189 @@
+//*********************************************************************************************************//
+//SensorDeadband header file
+//Change-threshold filter of sensors samples: only meaningful changes and heartbeats are published
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//deadband of one sensor
+	struct SensorDeadbandConfig
+	{
+		//publish if |value - published| >= absThreshold (0 - not used)
+		double absThreshold = 0.0;
+		//publish if |value - published| >= relThreshold * |published| and value changed (0 - not used)
+		double relThreshold = 0.0;
+		//publish unchanged value if nothing was published for this time, msec (0 - no heartbeat)
+		int64_t maxSilence = 0;
+	};
+
+	//filter counters
+	struct SensorDeadbandStats
+	{
+		//new samples checked
+		uint64_t samplesChecked = 0;
+		//published: first value, changes and heartbeats
+		uint64_t samplesPublished = 0;
+		uint64_t heartbeatsPublished = 0;
+		uint64_t samplesSuppressed = 0;
+
+		//part of samples not published, 0..1
+		double SuppressionRatio() const
+		{
+			return samplesChecked > 0 ? static_cast<double>(samplesSuppressed) / static_cast<double>(samplesChecked) : 0.0;
+		}
+	};
+
+	/* deadband filter, stays between scanner and database adapter */
+	/* remembers last published value of every sensor, config per sensor handle or default */
+	/* both thresholds zero - any change is published */
+	class SensorDeadband
+	{
+	private:
+		//sensor state, index = handle
+		struct SensorState
+		{
+			bool published = false;
+			double publishedValue = 0.0;
+			int64_t publishedTimestamp = 0;
+			//last checked sample (snapshot contains the same sample until new update)
+			int64_t checkedTimestamp = 0;
+			bool hasConfig = false;
+			SensorDeadbandConfig config = {};
+		};
+
+		SensorDeadbandConfig defaultConfig = {};
+		std::vector<SensorState> sensors = {};
+		SensorDeadbandStats stats = {};
+
+		SensorState& getState(SensorHandle handle)
+		{
+			if (static_cast<size_t>(handle) >= sensors.size())
+			{
+				sensors.resize(static_cast<size_t>(handle) + 1);
+			}
+			return sensors[handle];
+		}
+
+	public:
+		SensorDeadband()
+		{
+		}
+		explicit SensorDeadband(const SensorDeadbandConfig& config) : defaultConfig(config)
+		{
+		}
+		~SensorDeadband()
+		{
+		}
+
+		//config for sensors without own config
+		void SetDefaultConfig(const SensorDeadbandConfig& config)
+		{
+			defaultConfig = config;
+		}
+
+		//own config of sensor
+		void SetSensorConfig(SensorHandle handle, const SensorDeadbandConfig& config)
+		{
+			if (handle < 0)
+			{
+				return;
+			}
+			SensorState& state = getState(handle);
+			state.config = config;
+			state.hasConfig = true;
+		}
+
+		//check new sample, true - publish (sample becomes last published value)
+		bool ShouldPublish(SensorHandle handle, int64_t timestamp, double value)
+		{
+			if (handle < 0)
+			{
+				return false;
+			}
+			SensorState& state = getState(handle);
+			const SensorDeadbandConfig& config = state.hasConfig ? state.config : defaultConfig;
+			state.checkedTimestamp = timestamp;
+			stats.samplesChecked++;
+
+			bool publish = !state.published;
+			bool heartbeat = false;
+			if (!publish)
+			{
+				double delta = std::fabs(value - state.publishedValue);
+				if (config.absThreshold <= 0.0 && config.relThreshold <= 0.0)
+				{
+					publish = delta > 0.0;
+				}
+				else
+				{
+					//relative threshold of zero value is zero: unchanged zero (fan stopped, no load) is not published
+					publish = (config.absThreshold > 0.0 && delta >= config.absThreshold) ||
+						(config.relThreshold > 0.0 && delta > 0.0 && delta >= config.relThreshold * std::fabs(state.publishedValue));
+				}
+				heartbeat = !publish && config.maxSilence > 0 && timestamp - state.publishedTimestamp >= config.maxSilence;
+			}
+			if (!publish && !heartbeat)
+			{
+				stats.samplesSuppressed++;
+				return false;
+			}
+			state.published = true;
+			state.publishedValue = value;
+			state.publishedTimestamp = timestamp;
+			stats.samplesPublished++;
+			if (heartbeat)
+			{
+				stats.heartbeatsPublished++;
+			}
+			return true;
+		}
+
+		//check samples of snapshot which are newer than last checked, onPublish(handle) for samples to publish
+		template <typename publishHandler>
+		void Filter(const SensorSnapshot& snapshot, publishHandler&& onPublish)
+		{
+			for (size_t i = 0; i < snapshot.Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (!snapshot.HasValue(handle) ||
+					(i < sensors.size() && sensors[i].published && snapshot.Timestamp(handle) <= sensors[i].checkedTimestamp))
+				{
+					continue;
+				}
+				if (ShouldPublish(handle, snapshot.Timestamp(handle), snapshot.Value(handle)))
+				{
+					onPublish(handle);
+				}
+			}
+		}
+
+		//forget published value (e.g. after database write error), next sample is published
+		void Invalidate(SensorHandle handle)
+		{
+			if (handle >= 0 && static_cast<size_t>(handle) < sensors.size())
+			{
+				sensors[handle].published = false;
+			}
+		}
+
+		const SensorDeadbandStats& GetStats() const
+		{
+			return stats;
+		}
+
+		void ResetStats()
+		{
+			stats = {};
+		}
+	};
+}
@@ -0,0 +1,229 @@
+//*********************************************************************************************************//
+//SensorHistory header file
+//Per-sensor time-series ring buffers with sliding-window min/max/mean
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//statistics of one sensor in sliding window
+	struct SensorWindowStats
+	{
+		size_t count = 0;
+		double minValue = 0.0;
+		double maxValue = 0.0;
+		double meanValue = 0.0;
+		int64_t firstTimestamp = 0;
+		int64_t lastTimestamp = 0;
+	};
+
+	/* ring buffers of samples for all sensors */
+	/* storage is preallocated per sensor and contiguous: [handle * capacity + position] */
+	/* windows are updated on every append: running sum and monotonic min/max queues, */
+	/* each sample enters and leaves every queue once - O(1) amortized append and O(1) query */
+	class SensorHistory
+	{
+	private:
+		//window state of one sensor
+		struct WindowState
+		{
+			//sequence number of oldest sample in window
+			uint64_t startSeq = 0;
+			double sum = 0.0;
+			//monotonic queues of sample sequence numbers: [head, tail)
+			uint64_t minHead = 0, minTail = 0;
+			uint64_t maxHead = 0, maxTail = 0;
+		};
+
+		//samples per sensor (retention)
+		size_t capacity = 0;
+		//window durations, msec
+		std::vector<int64_t> windows = {};
+		size_t sensorsCount = 0;
+		//samples: [handle * capacity + seq % capacity]
+		std::vector<double> values = {};
+		std::vector<int64_t> timestamps = {};
+		//number of samples written for every sensor (next sequence number)
+		std::vector<uint64_t> writeSeq = {};
+		//windows: [handle * windows count + window]
+		std::vector<WindowState> windowStates = {};
+		//monotonic queues storage: [(handle * windows count + window) * capacity + seq % capacity]
+		std::vector<uint64_t> minQueues = {};
+		std::vector<uint64_t> maxQueues = {};
+
+		//allocate storage for new sensors
+		void reserveSensor(SensorHandle handle)
+		{
+			if (static_cast<size_t>(handle) < sensorsCount)
+			{
+				return;
+			}
+			sensorsCount = static_cast<size_t>(handle) + 1;
+			values.resize(sensorsCount * capacity);
+			timestamps.resize(sensorsCount * capacity);
+			writeSeq.resize(sensorsCount);
+			windowStates.resize(sensorsCount * windows.size());
+			minQueues.resize(sensorsCount * windows.size() * capacity);
+			maxQueues.resize(sensorsCount * windows.size() * capacity);
+		}
+
+	public:
+		//samplesCapacity - retention per sensor, windowDurations - sliding windows, msec
+		SensorHistory(size_t samplesCapacity, const std::vector<int64_t>& windowDurations) :
+			capacity(samplesCapacity > 0 ? samplesCapacity : 1), windows(windowDurations)
+		{
+		}
+		~SensorHistory()
+		{
+		}
+
+		//add sample of one sensor, timestamps must not decrease
+		void Append(SensorHandle handle, int64_t timestamp, double value)
+		{
+			if (handle < 0)
+			{
+				return;
+			}
+			reserveSensor(handle);
+
+			uint64_t seq = writeSeq[handle]++;
+			size_t sampleBase = static_cast<size_t>(handle) * capacity;
+			//oldest sample which stays in ring after write
+			uint64_t oldestSeq = seq >= capacity ? seq + 1 - capacity : 0;
+
+			//expire samples out of window duration or overwritten by this sample
+			for (size_t w = 0; w < windows.size(); w++)
+			{
+				size_t windowIdx = static_cast<size_t>(handle) * windows.size() + w;
+				WindowState& window = windowStates[windowIdx];
+				const uint64_t* minQueue = &minQueues[windowIdx * capacity];
+				const uint64_t* maxQueue = &maxQueues[windowIdx * capacity];
+				int64_t windowStart = timestamp - windows[w];
+				while (window.startSeq < seq &&
+					(window.startSeq < oldestSeq || timestamps[sampleBase + window.startSeq % capacity] <= windowStart))
+				{
+					window.sum -= values[sampleBase + window.startSeq % capacity];
+					window.startSeq++;
+				}
+				while (window.minHead < window.minTail && minQueue[window.minHead % capacity] < window.startSeq)
+				{
+					window.minHead++;
+				}
+				while (window.maxHead < window.maxTail && maxQueue[window.maxHead % capacity] < window.startSeq)
+				{
+					window.maxHead++;
+				}
+			}
+
+			values[sampleBase + seq % capacity] = value;
+			timestamps[sampleBase + seq % capacity] = timestamp;
+
+			//add sample: sum and monotonic queues (drop samples which can't be min/max anymore)
+			for (size_t w = 0; w < windows.size(); w++)
+			{
+				size_t windowIdx = static_cast<size_t>(handle) * windows.size() + w;
+				WindowState& window = windowStates[windowIdx];
+				uint64_t* minQueue = &minQueues[windowIdx * capacity];
+				uint64_t* maxQueue = &maxQueues[windowIdx * capacity];
+				window.sum += value;
+				while (window.minTail > window.minHead && values[sampleBase + minQueue[(window.minTail - 1) % capacity] % capacity] >= value)
+				{
+					window.minTail--;
+				}
+				minQueue[window.minTail++ % capacity] = seq;
+				while (window.maxTail > window.maxHead && values[sampleBase + maxQueue[(window.maxTail - 1) % capacity] % capacity] <= value)
+				{
+					window.maxTail--;
+				}
+				maxQueue[window.maxTail++ % capacity] = seq;
+			}
+		}
+
+		//add all sensors samples from snapshot which are newer than last appended
+		void AppendSnapshot(const SensorSnapshot& snapshot)
+		{
+			for (size_t i = 0; i < snapshot.Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (snapshot.HasValue(handle) &&
+					(static_cast<size_t>(handle) >= sensorsCount || writeSeq[handle] == 0 ||
+						snapshot.Timestamp(handle) > LastTimestamp(handle)))
+				{
+					Append(handle, snapshot.Timestamp(handle), snapshot.Value(handle));
+				}
+			}
+		}
+
+		//statistics of sensor in window (relative to last sample of this sensor), O(1)
+		bool GetWindowStats(SensorHandle handle, size_t window, SensorWindowStats& stats) const
+		{
+			if (handle < 0 || static_cast<size_t>(handle) >= sensorsCount || window >= windows.size() || writeSeq[handle] == 0)
+			{
+				return false;
+			}
+			size_t windowIdx = static_cast<size_t>(handle) * windows.size() + window;
+			size_t sampleBase = static_cast<size_t>(handle) * capacity;
+			const WindowState& windowState = windowStates[windowIdx];
+			uint64_t lastSeq = writeSeq[handle] - 1;
+
+			stats.count = static_cast<size_t>(lastSeq - windowState.startSeq + 1);
+			stats.minValue = values[sampleBase + minQueues[windowIdx * capacity + windowState.minHead % capacity] % capacity];
+			stats.maxValue = values[sampleBase + maxQueues[windowIdx * capacity + windowState.maxHead % capacity] % capacity];
+			stats.meanValue = windowState.sum / static_cast<double>(stats.count);
+			stats.firstTimestamp = timestamps[sampleBase + windowState.startSeq % capacity];
+			stats.lastTimestamp = timestamps[sampleBase + lastSeq % capacity];
+			return true;
+		}
+
+		//number of stored samples of sensor
+		size_t SamplesCount(SensorHandle handle) const
+		{
+			if (handle < 0 || static_cast<size_t>(handle) >= sensorsCount)
+			{
+				return 0;
+			}
+			return writeSeq[handle] < capacity ? static_cast<size_t>(writeSeq[handle]) : capacity;
+		}
+
+		//stored sample by age: 0 - newest
+		bool GetSample(SensorHandle handle, size_t age, int64_t& timestamp, double& value) const
+		{
+			if (age >= SamplesCount(handle))
+			{
+				return false;
+			}
+			size_t samplePos = static_cast<size_t>(handle) * capacity + (writeSeq[handle] - 1 - age) % capacity;
+			timestamp = timestamps[samplePos];
+			value = values[samplePos];
+			return true;
+		}
+
+		//timestamp of newest sample of sensor (0 if no samples)
+		int64_t LastTimestamp(SensorHandle handle) const
+		{
+			if (handle < 0 || static_cast<size_t>(handle) >= sensorsCount || writeSeq[handle] == 0)
+			{
+				return 0;
+			}
+			return timestamps[static_cast<size_t>(handle) * capacity + (writeSeq[handle] - 1) % capacity];
+		}
+
+		size_t Capacity() const
+		{
+			return capacity;
+		}
+
+		size_t WindowsCount() const
+		{
+			return windows.size();
+		}
+	};
+}
@@ -0,0 +1,348 @@
+//*********************************************************************************************************//
+//SensorHistoryFile header file
+//Sensors history in fixed-size memory-mapped ring file with sparse time index (survives restart)
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include "SharedMemoryView.h"
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	/* file layout (all sections aligned to page): */
+	/* header | sensors names | chunks index | records */
+	/* records ring is split to chunks, index entry of chunk keeps min/max timestamp of its records: */
+	/* time range query reads only index and records of chunks in range */
+	class SensorHistoryFile
+	{
+	private:
+		static constexpr char HISTORY_FILE_MAGIC[8] = { 'P', 'C', 'T', 'H', 'I', 'S', 'T', '\0' };
+		static constexpr uint32_t HISTORY_FILE_VERSION = 2;
+		static constexpr size_t HISTORY_FILE_PAGE_SIZE = 4096;
+		static constexpr size_t HISTORY_FILE_NAME_SIZE = 64;
+
+		struct FileHeader
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t maxSensors;
+			uint64_t chunkRecords;
+			uint64_t chunksCount;
+			//number of records written since file creation, record is valid only after this counter update
+			uint64_t writeSeq;
+			uint32_t sensorsCount;
+			uint32_t reserved;
+		};
+		struct FileChunk
+		{
+			//chunk number + 1 (0 - empty)
+			uint64_t chunkNumber;
+			int64_t minTimestamp;
+			int64_t maxTimestamp;
+		};
+		struct FileRecord
+		{
+			int64_t timestamp;
+			double value;
+			uint32_t sensorId;
+			uint32_t reserved;
+		};
+		static_assert(sizeof(FileHeader) == 48 && sizeof(FileChunk) == 24 && sizeof(FileRecord) == 24,
+			"history file structures must not have padding");
+
+		SharedMemoryView fileView;
+		FileHeader* header = nullptr;
+		char* names = nullptr;
+		FileChunk* chunks = nullptr;
+		FileRecord* records = nullptr;
+		//sensor name -> id in file
+		std::unordered_map<std::string, uint32_t> sensorIds = {};
+		//scanner handle -> id in file (-1 - not resolved yet, -2 - no free place in names table)
+		std::vector<int> handleIds = {};
+		std::vector<int64_t> handleTimestamps = {};
+
+		static size_t alignToPage(size_t offset)
+		{
+			return (offset + HISTORY_FILE_PAGE_SIZE - 1) / HISTORY_FILE_PAGE_SIZE * HISTORY_FILE_PAGE_SIZE;
+		}
+
+		//name in names table: up to 63 chars as is, longer - prefix + '~' + hash of full name (16 hex digits)
+		//long names with same prefix get different ids, hash is stable between runs (FNV-1a)
+		static std::string storedName(const std::string& name)
+		{
+			if (name.size() < HISTORY_FILE_NAME_SIZE)
+			{
+				return name;
+			}
+			uint64_t nameHash = 14695981039346656037ULL;
+			for (char nameChar : name)
+			{
+				nameHash = (nameHash ^ static_cast<unsigned char>(nameChar)) * 1099511628211ULL;
+			}
+			static constexpr char hexDigits[] = "0123456789abcdef";
+			std::string hashText(16, '0');
+			for (size_t i = 0; i < hashText.size(); i++)
+			{
+				hashText[hashText.size() - 1 - i] = hexDigits[(nameHash >> (i * 4)) & 0xF];
+			}
+			return name.substr(0, HISTORY_FILE_NAME_SIZE - 1 - hashText.size() - 1) + "~" + hashText;
+		}
+
+		//file id of scanner sensor, registered on first use
+		int resolveHandle(const SensorSnapshot& snapshot, SensorHandle handle)
+		{
+			if (static_cast<size_t>(handle) >= handleIds.size())
+			{
+				handleIds.resize(static_cast<size_t>(handle) + 1, -1);
+				handleTimestamps.resize(static_cast<size_t>(handle) + 1, 0);
+			}
+			if (handleIds[handle] == -1)
+			{
+				handleIds[handle] = RegisterSensor(snapshot.Name(handle));
+				handleIds[handle] = handleIds[handle] < 0 ? -2 : handleIds[handle];
+			}
+			return handleIds[handle];
+		}
+
+	public:
+		SensorHistoryFile()
+		{
+		}
+		~SensorHistoryFile()
+		{
+			Close();
+		}
+		SensorHistoryFile(const SensorHistoryFile&) = delete;
+		SensorHistoryFile& operator=(const SensorHistoryFile&) = delete;
+
+		//open existing history file or create new, capacity = chunkRecords * chunksCount records
+		//file with other format or parameters is cleared
+		bool Open(const std::string& path, size_t chunkRecords, size_t chunksCount, size_t maxSensors)
+		{
+			Close();
+			if (chunkRecords == 0 || chunksCount == 0 || maxSensors == 0)
+			{
+				return false;
+			}
+			size_t namesOffset = HISTORY_FILE_PAGE_SIZE;
+			size_t chunksOffset = alignToPage(namesOffset + maxSensors * HISTORY_FILE_NAME_SIZE);
+			size_t recordsOffset = alignToPage(chunksOffset + chunksCount * sizeof(FileChunk));
+			size_t fileSize = alignToPage(recordsOffset + chunkRecords * chunksCount * sizeof(FileRecord));
+			if (!fileView.OpenFile(path, fileSize))
+			{
+				return false;
+			}
+			char* fileData = static_cast<char*>(fileView.Data());
+			header = reinterpret_cast<FileHeader*>(fileData);
+			names = fileData + namesOffset;
+			chunks = reinterpret_cast<FileChunk*>(fileData + chunksOffset);
+			records = reinterpret_cast<FileRecord*>(fileData + recordsOffset);
+
+			if (std::memcmp(header->magic, HISTORY_FILE_MAGIC, sizeof(HISTORY_FILE_MAGIC)) != 0 ||
+				header->version != HISTORY_FILE_VERSION ||
+				header->maxSensors != maxSensors ||
+				header->chunkRecords != chunkRecords ||
+				header->chunksCount != chunksCount ||
+				header->sensorsCount > maxSensors)
+			{
+				//new file: header, names and index (records are valid only by index)
+				std::memset(fileData, 0, recordsOffset);
+				std::memcpy(header->magic, HISTORY_FILE_MAGIC, sizeof(HISTORY_FILE_MAGIC));
+				header->version = HISTORY_FILE_VERSION;
+				header->maxSensors = static_cast<uint32_t>(maxSensors);
+				header->chunkRecords = chunkRecords;
+				header->chunksCount = chunksCount;
+			}
+			for (uint32_t id = 0; id < header->sensorsCount; id++)
+			{
+				sensorIds[SensorName(id)] = id;
+			}
+			return true;
+		}
+
+		void Close()
+		{
+			fileView.Close();
+			header = nullptr;
+			names = nullptr;
+			chunks = nullptr;
+			records = nullptr;
+			sensorIds.clear();
+			handleIds.clear();
+			handleTimestamps.clear();
+		}
+
+		bool IsOpen() const
+		{
+			return header != nullptr;
+		}
+
+		//find or add sensor name, return id in file or -1 (names table full or file not open)
+		//names longer than 63 chars are stored shortened with hash of full name (see SensorName)
+		int RegisterSensor(const std::string& name)
+		{
+			if (header == nullptr)
+			{
+				return -1;
+			}
+			std::string fileName = storedName(name);
+			std::unordered_map<std::string, uint32_t>::const_iterator findedEl = sensorIds.find(fileName);
+			if (findedEl != sensorIds.end())
+			{
+				return static_cast<int>(findedEl->second);
+			}
+			if (header->sensorsCount >= header->maxSensors)
+			{
+				return -1;
+			}
+			uint32_t id = header->sensorsCount;
+			std::memcpy(names + id * HISTORY_FILE_NAME_SIZE, fileName.c_str(), fileName.size() + 1);
+			header->sensorsCount++;
+			sensorIds[fileName] = id;
+			return static_cast<int>(id);
+		}
+
+		//write one record (no allocations, no syscalls)
+		void Append(uint32_t sensorId, int64_t timestamp, double value)
+		{
+			if (header == nullptr)
+			{
+				return;
+			}
+			uint64_t seq = header->writeSeq;
+			uint64_t chunkNumber = seq / header->chunkRecords;
+			uint64_t chunkPos = seq % header->chunkRecords;
+			FileChunk& chunk = chunks[chunkNumber % header->chunksCount];
+			if (chunkPos == 0)
+			{
+				//chunk slot is reused: old records are not valid anymore
+				chunk.chunkNumber = chunkNumber + 1;
+				chunk.minTimestamp = timestamp;
+				chunk.maxTimestamp = timestamp;
+			}
+			else
+			{
+				chunk.minTimestamp = timestamp < chunk.minTimestamp ? timestamp : chunk.minTimestamp;
+				chunk.maxTimestamp = timestamp > chunk.maxTimestamp ? timestamp : chunk.maxTimestamp;
+			}
+			FileRecord& record = records[(chunkNumber % header->chunksCount) * header->chunkRecords + chunkPos];
+			record.timestamp = timestamp;
+			record.value = value;
+			record.sensorId = sensorId;
+			record.reserved = 0;
+			header->writeSeq = seq + 1;
+		}
+
+		//write samples of all sensors from snapshot which are newer than last written
+		void AppendSnapshot(const SensorSnapshot& snapshot)
+		{
+			for (size_t i = 0; i < snapshot.Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (!snapshot.HasValue(handle))
+				{
+					continue;
+				}
+				int sensorId = resolveHandle(snapshot, handle);
+				if (sensorId >= 0 && snapshot.Timestamp(handle) > handleTimestamps[handle])
+				{
+					Append(static_cast<uint32_t>(sensorId), snapshot.Timestamp(handle), snapshot.Value(handle));
+					handleTimestamps[handle] = snapshot.Timestamp(handle);
+				}
+			}
+		}
+
+		//records of all sensors in [fromTimestamp, toTimestamp], onSample(sensorId, timestamp, value)
+		//oldest chunks first, only chunks with intersecting time range are read
+		template <typename sampleHandler>
+		void ForEachSample(int64_t fromTimestamp, int64_t toTimestamp, sampleHandler&& onSample) const
+		{
+			if (header == nullptr || header->writeSeq == 0)
+			{
+				return;
+			}
+			uint64_t recordsCount = header->writeSeq;
+			uint64_t lastChunk = (recordsCount - 1) / header->chunkRecords;
+			uint64_t firstChunk = lastChunk + 1 > header->chunksCount ? lastChunk + 1 - header->chunksCount : 0;
+			for (uint64_t chunkNumber = firstChunk; chunkNumber <= lastChunk; chunkNumber++)
+			{
+				const FileChunk& chunk = chunks[chunkNumber % header->chunksCount];
+				if (chunk.chunkNumber != chunkNumber + 1 ||
+					chunk.maxTimestamp < fromTimestamp || chunk.minTimestamp > toTimestamp)
+				{
+					continue;
+				}
+				uint64_t chunkEnd = chunkNumber == lastChunk ? recordsCount - chunkNumber * header->chunkRecords : header->chunkRecords;
+				const FileRecord* chunkRecords = &records[(chunkNumber % header->chunksCount) * header->chunkRecords];
+				for (uint64_t pos = 0; pos < chunkEnd; pos++)
+				{
+					const FileRecord& record = chunkRecords[pos];
+					if (record.timestamp >= fromTimestamp && record.timestamp <= toTimestamp && record.sensorId < header->sensorsCount)
+					{
+						onSample(record.sensorId, record.timestamp, record.value);
+					}
+				}
+			}
+		}
+
+		//sensor name by id in file (names longer than 63 chars: first 46 chars + '~' + hash of full name)
+		std::string SensorName(uint32_t sensorId) const
+		{
+			if (header == nullptr || sensorId >= header->sensorsCount)
+			{
+				return "";
+			}
+			const char* name = names + sensorId * HISTORY_FILE_NAME_SIZE;
+			return std::string(name, strnlen(name, HISTORY_FILE_NAME_SIZE - 1));
+		}
+
+		//id of sensor in file by name, -1 if not found
+		int FindSensor(const std::string& name) const
+		{
+			std::unordered_map<std::string, uint32_t>::const_iterator findedEl = sensorIds.find(storedName(name));
+			return findedEl != sensorIds.end() ? static_cast<int>(findedEl->second) : -1;
+		}
+
+		size_t SensorsCount() const
+		{
+			return header != nullptr ? header->sensorsCount : 0;
+		}
+
+		//number of stored records
+		uint64_t RecordsCount() const
+		{
+			if (header == nullptr)
+			{
+				return 0;
+			}
+			//first chunk of ring is overwritten by last chunk
+			uint64_t capacity = header->chunkRecords * header->chunksCount;
+			if (header->writeSeq <= capacity)
+			{
+				return header->writeSeq;
+			}
+			uint64_t lastChunk = (header->writeSeq - 1) / header->chunkRecords;
+			return (header->chunksCount - 1) * header->chunkRecords + header->writeSeq - lastChunk * header->chunkRecords;
+		}
+
+		//start writing changed pages to disk (data is kept by system on process exit without it)
+		bool Flush()
+		{
+			return fileView.Flush();
+		}
+
+		int LastError() const
+		{
+			return fileView.LastError();
+		}
+	};
+}
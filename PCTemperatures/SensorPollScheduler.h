@@ -0,0 +1,269 @@
+//*********************************************************************************************************//
+//SensorPollScheduler header file
+//Adaptive polling: learns producer update cadence of every provider and polls just after publication
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//poll statistics of one provider
+	struct SensorPollStats
+	{
+		uint64_t pollsTotal = 0;
+		//poll found new data
+		uint64_t pollsWithData = 0;
+		//poll found nothing new
+		uint64_t pollsWasted = 0;
+		//staleness: time between estimated producer publication and poll which got new data, msec
+		int64_t stalenessSum = 0;
+		int64_t stalenessMax = 0;
+		//learned producer period, msec (0 - not known yet)
+		int64_t estimatedPeriod = 0;
+
+		double AverageStaleness() const
+		{
+			return pollsWithData > 0 ? static_cast<double>(stalenessSum) / static_cast<double>(pollsWithData) : 0.0;
+		}
+
+		double WastedRatio() const
+		{
+			return pollsTotal > 0 ? static_cast<double>(pollsWasted) / static_cast<double>(pollsTotal) : 0.0;
+		}
+	};
+
+	/* poll scheduler for set of providers */
+	/* period: from producer timestamps (hint) or intervals between detected changes, smoothed, */
+	/* intervals over several periods (missed publications) are divided to periods count; */
+	/* interval is measured only if publication is bracketed by poll without new data before it, */
+	/* new data on many polls in a row - period can be overestimated (aliasing), one poll at half period is probed */
+	/* phase: publication is between previous and current poll - estimate is clamped to this range, */
+	/* next poll = estimated publication + period + guard delay; poll without new data after expected */
+	/* publication - short retry; while period is unknown polls without new data back off to max interval */
+	class SensorPollScheduler
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+	private:
+		struct ProviderState
+		{
+			bool hasPoll = false;
+			Clock::time_point lastPollTime = {};
+			//estimated time of last producer publication
+			bool hasPublication = false;
+			Clock::time_point publicationTime = {};
+			//smoothed period, msec
+			double period = 0.0;
+			int missesInRow = 0;
+			int hitsInRow = 0;
+			//next poll is half period probe
+			bool probeActive = false;
+			Clock::time_point nextPollTime = {};
+			SensorPollStats stats;
+		};
+
+		//polls with new data in a row before shorter period probe
+		static constexpr int PROBE_HITS_COUNT = 8;
+		//polls without new data in a row at learn interval before back off (period is unknown)
+		static constexpr int LEARN_MISSES_COUNT = 10;
+
+		std::vector<ProviderState> providers = {};
+		//poll interval limits and poll interval while period is unknown
+		std::chrono::milliseconds minInterval = std::chrono::milliseconds(50);
+		std::chrono::milliseconds maxInterval = std::chrono::milliseconds(10000);
+		std::chrono::milliseconds learnInterval = std::chrono::milliseconds(100);
+		//delay after expected publication
+		std::chrono::milliseconds guardDelay = std::chrono::milliseconds(20);
+
+		static int64_t toMsec(Clock::duration duration)
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+		}
+
+	public:
+		SensorPollScheduler()
+		{
+		}
+		~SensorPollScheduler()
+		{
+		}
+
+		//number of providers (new providers are due immediately)
+		void Resize(size_t providersCount)
+		{
+			providers.resize(providersCount);
+		}
+
+		//min/max poll interval, interval of polls while producer period is not known
+		void SetIntervals(std::chrono::milliseconds minPollInterval, std::chrono::milliseconds maxPollInterval,
+			std::chrono::milliseconds learnPollInterval)
+		{
+			minInterval = minPollInterval;
+			maxInterval = maxPollInterval > minPollInterval ? maxPollInterval : minPollInterval;
+			learnInterval = learnPollInterval;
+		}
+
+		void SetGuardDelay(std::chrono::milliseconds delay)
+		{
+			guardDelay = delay;
+		}
+
+		bool IsDue(size_t provider, Clock::time_point timeNow) const
+		{
+			return timeNow >= providers[provider].nextPollTime;
+		}
+
+		//poll result: pollTime - time of data read, newData - producer published since previous poll
+		//periodHint - producer period from its own timestamps, msec (0 - unknown)
+		void OnPoll(size_t provider, Clock::time_point pollTime, bool newData, int64_t periodHint)
+		{
+			ProviderState& state = providers[provider];
+			state.stats.pollsTotal++;
+			if (newData)
+			{
+				state.stats.pollsWithData++;
+				//publication estimate: previous + period, but between previous and current poll
+				Clock::time_point publication = pollTime;
+				if (state.hasPublication && state.period > 0.0)
+				{
+					publication = state.publicationTime + std::chrono::milliseconds(static_cast<int64_t>(state.period));
+				}
+				if (state.hasPoll && publication < state.lastPollTime)
+				{
+					publication = state.lastPollTime;
+				}
+				if (publication > pollTime)
+				{
+					publication = pollTime;
+				}
+				//staleness (first poll - unknown publication time)
+				if (state.hasPoll)
+				{
+					int64_t staleness = toMsec(pollTime - publication);
+					state.stats.stalenessSum += staleness;
+					state.stats.stalenessMax = staleness > state.stats.stalenessMax ? staleness : state.stats.stalenessMax;
+				}
+
+				//period sample
+				double periodSample = 0.0;
+				if (periodHint > 0)
+				{
+					periodSample = static_cast<double>(periodHint);
+				}
+				else if (state.hasPublication && (state.missesInRow > 0 || state.probeActive || state.period <= 0.0))
+				{
+					periodSample = static_cast<double>(toMsec(publication - state.publicationTime));
+				}
+				if (periodSample > 0.0)
+				{
+					if (state.period > 0.0 && periodSample > 1.5 * state.period)
+					{
+						periodSample /= static_cast<double>(static_cast<int64_t>(periodSample / state.period + 0.5));
+					}
+					state.period = state.period > 0.0 ? state.period * 0.75 + periodSample * 0.25 : periodSample;
+					double minPeriod = static_cast<double>(minInterval.count());
+					double maxPeriod = static_cast<double>(maxInterval.count());
+					state.period = state.period < minPeriod ? minPeriod : (state.period > maxPeriod ? maxPeriod : state.period);
+					state.stats.estimatedPeriod = static_cast<int64_t>(state.period);
+				}
+				state.hasPublication = true;
+				state.publicationTime = publication;
+				state.hitsInRow = state.missesInRow > 0 || state.probeActive ? 0 : state.hitsInRow + 1;
+				state.missesInRow = 0;
+				state.probeActive = false;
+
+				//next poll just after next publication
+				if (state.period > 0.0)
+				{
+					std::chrono::milliseconds period(static_cast<int64_t>(state.period));
+					state.nextPollTime = publication + period + guardDelay;
+					if (periodHint <= 0 && state.hitsInRow >= PROBE_HITS_COUNT)
+					{
+						//probe: producer can publish more often than estimated
+						state.nextPollTime = publication + period / 2;
+						state.probeActive = true;
+						state.hitsInRow = 0;
+					}
+					while (state.nextPollTime <= pollTime)
+					{
+						state.nextPollTime += period;
+					}
+				}
+				else
+				{
+					state.nextPollTime = pollTime + learnInterval;
+				}
+			}
+			else
+			{
+				state.stats.pollsWasted++;
+				Clock::time_point expectedPollTime = state.publicationTime +
+					std::chrono::milliseconds(static_cast<int64_t>(state.period)) + guardDelay;
+				if (state.probeActive)
+				{
+					//probe confirmed period, back to expected publication
+					state.probeActive = false;
+				}
+				else
+				{
+					state.missesInRow++;
+				}
+				if (state.period <= 0.0)
+				{
+					//period not known yet: source without new data after learning polls is absent or stopped,
+					//back off up to max interval
+					int backoffShift = state.missesInRow - LEARN_MISSES_COUNT;
+					backoffShift = backoffShift > 0 ? (backoffShift < 16 ? backoffShift : 16) : 0;
+					int64_t retryMsec = learnInterval.count() << backoffShift;
+					retryMsec = retryMsec < maxInterval.count() ? retryMsec : maxInterval.count();
+					state.nextPollTime = pollTime + std::chrono::milliseconds(retryMsec);
+				}
+				else if (state.hasPublication && expectedPollTime > pollTime)
+				{
+					state.nextPollTime = expectedPollTime;
+				}
+				else
+				{
+					//retry soon, back off if producer stopped
+					int64_t retryMsec = static_cast<int64_t>(state.period / 8.0);
+					retryMsec = retryMsec > minInterval.count() ? retryMsec : minInterval.count();
+					//missesInRow is 0 after missed probe
+					int backoffShift = state.missesInRow > 1 ? state.missesInRow - 1 : 0;
+					retryMsec <<= (backoffShift < 5 ? backoffShift : 5);
+					retryMsec = retryMsec < maxInterval.count() ? retryMsec : maxInterval.count();
+					state.nextPollTime = pollTime + std::chrono::milliseconds(retryMsec);
+				}
+			}
+			state.hasPoll = true;
+			state.lastPollTime = pollTime;
+		}
+
+		Clock::time_point GetNextPollTime(size_t provider) const
+		{
+			return providers[provider].nextPollTime;
+		}
+
+		//nearest poll of all providers
+		Clock::time_point GetNextPollTime() const
+		{
+			Clock::time_point nextPollTime = Clock::time_point::max();
+			for (const ProviderState& state : providers)
+			{
+				nextPollTime = state.nextPollTime < nextPollTime ? state.nextPollTime : nextPollTime;
+			}
+			return nextPollTime;
+		}
+
+		const SensorPollStats& GetStats(size_t provider) const
+		{
+			return providers[provider].stats;
+		}
+	};
+}
@@ -0,0 +1,456 @@
+//*********************************************************************************************************//
+//SensorQuantileSketch header file
+//Mergeable streaming quantile sketches (KLL) of sensors samples, per sensor and per time window
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	/* KLL sketch: levels of items, item of level h has weight 2^h */
+	/* full level is sorted and every second item (random offset) goes to next level */
+	/* memory ~ 3 * k items for any number of samples, rank error ~ 1.7 / k */
+	class SensorQuantileSketch
+	{
+	private:
+		//accuracy parameter (size of top level)
+		int k = 200;
+		std::vector<std::vector<double>> levels = {};
+		uint64_t count = 0;
+		double minValue = 0.0;
+		double maxValue = 0.0;
+		//state of random generator for compaction offsets
+		uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+
+		//capacity of level: k * (2/3)^(depth from top), at least 2
+		size_t levelCapacity(size_t level) const
+		{
+			size_t depth = levels.size() - 1 - level;
+			double capacity = static_cast<double>(k);
+			for (size_t i = 0; i < depth && capacity > 2.0; i++)
+			{
+				capacity *= 2.0 / 3.0;
+			}
+			return capacity > 2.0 ? static_cast<size_t>(capacity + 0.5) : 2;
+		}
+
+		bool randomBit()
+		{
+			randomState ^= randomState << 13;
+			randomState ^= randomState >> 7;
+			randomState ^= randomState << 17;
+			return (randomState & 1) != 0;
+		}
+
+		//compact first full level while sketch is over capacity
+		void compress()
+		{
+			while (true)
+			{
+				size_t level = 0;
+				for (; level < levels.size(); level++)
+				{
+					if (levels[level].size() >= levelCapacity(level))
+					{
+						break;
+					}
+				}
+				if (level == levels.size())
+				{
+					return;
+				}
+				if (level + 1 == levels.size())
+				{
+					levels.emplace_back();
+				}
+				std::vector<double>& items = levels[level];
+				std::vector<double>& nextItems = levels[level + 1];
+				std::sort(items.begin(), items.end());
+				//odd number of items - last item stays on level
+				size_t compactSize = items.size() & ~static_cast<size_t>(1);
+				for (size_t i = randomBit() ? 1 : 0; i < compactSize; i += 2)
+				{
+					nextItems.push_back(items[i]);
+				}
+				items.erase(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(compactSize));
+			}
+		}
+
+	public:
+		explicit SensorQuantileSketch(int accuracy = 200) : k(accuracy > 8 ? accuracy : 8)
+		{
+			levels.emplace_back();
+		}
+		~SensorQuantileSketch()
+		{
+		}
+
+		void Update(double value)
+		{
+			if (count == 0)
+			{
+				minValue = value;
+				maxValue = value;
+			}
+			minValue = value < minValue ? value : minValue;
+			maxValue = value > maxValue ? value : maxValue;
+			count++;
+			levels[0].push_back(value);
+			if (levels[0].size() >= levelCapacity(0))
+			{
+				compress();
+			}
+		}
+
+		//add all samples of other sketch (e.g. per-minute sketches of fleet)
+		void Merge(const SensorQuantileSketch& other)
+		{
+			if (other.count == 0)
+			{
+				return;
+			}
+			if (count == 0)
+			{
+				minValue = other.minValue;
+				maxValue = other.maxValue;
+			}
+			minValue = other.minValue < minValue ? other.minValue : minValue;
+			maxValue = other.maxValue > maxValue ? other.maxValue : maxValue;
+			count += other.count;
+			if (other.levels.size() > levels.size())
+			{
+				levels.resize(other.levels.size());
+			}
+			for (size_t level = 0; level < other.levels.size(); level++)
+			{
+				levels[level].insert(levels[level].end(), other.levels[level].begin(), other.levels[level].end());
+			}
+			compress();
+		}
+
+		//value at quantile q (0..1), 0 if sketch is empty
+		double Quantile(double q) const
+		{
+			if (count == 0)
+			{
+				return 0.0;
+			}
+			if (q <= 0.0)
+			{
+				return minValue;
+			}
+			if (q >= 1.0)
+			{
+				return maxValue;
+			}
+			std::vector<std::pair<double, uint64_t>> weighted;
+			uint64_t totalWeight = 0;
+			for (size_t level = 0; level < levels.size(); level++)
+			{
+				for (double item : levels[level])
+				{
+					weighted.emplace_back(item, 1ULL << level);
+					totalWeight += 1ULL << level;
+				}
+			}
+			std::sort(weighted.begin(), weighted.end());
+			double targetWeight = q * static_cast<double>(totalWeight);
+			uint64_t cumWeight = 0;
+			for (const std::pair<double, uint64_t>& item : weighted)
+			{
+				cumWeight += item.second;
+				if (static_cast<double>(cumWeight) >= targetWeight)
+				{
+					return item.first;
+				}
+			}
+			return maxValue;
+		}
+
+		uint64_t Count() const
+		{
+			return count;
+		}
+
+		double Min() const
+		{
+			return minValue;
+		}
+
+		double Max() const
+		{
+			return maxValue;
+		}
+
+		//number of stored items (memory usage)
+		size_t ItemsCount() const
+		{
+			size_t itemsCount = 0;
+			for (const std::vector<double>& items : levels)
+			{
+				itemsCount += items.size();
+			}
+			return itemsCount;
+		}
+
+		void Clear()
+		{
+			levels.assign(1, {});
+			count = 0;
+			minValue = 0.0;
+			maxValue = 0.0;
+		}
+
+		//text form for upload: "k;count;min;max;level0 items;level1 items;..." (items separated by ',')
+		std::string Serialize() const
+		{
+			std::string text;
+			char numBuf[32];
+			auto addNumber = [&text, &numBuf](auto number)
+			{
+				std::to_chars_result convRes = std::to_chars(numBuf, numBuf + sizeof(numBuf), number);
+				text.append(numBuf, convRes.ptr);
+			};
+			addNumber(k);
+			text += ';';
+			addNumber(count);
+			text += ';';
+			addNumber(minValue);
+			text += ';';
+			addNumber(maxValue);
+			for (const std::vector<double>& items : levels)
+			{
+				text += ';';
+				for (size_t i = 0; i < items.size(); i++)
+				{
+					if (i > 0)
+					{
+						text += ',';
+					}
+					addNumber(items[i]);
+				}
+			}
+			return text;
+		}
+
+		//restore sketch from Serialize() text, false if text is malformed (sketch is cleared)
+		bool Deserialize(std::string_view text)
+		{
+			Clear();
+			size_t pos = 0;
+			//read number till separator, move pos after separator
+			auto readNumber = [&text, &pos](auto& number) -> bool
+			{
+				const char* textEnd = text.data() + text.size();
+				std::from_chars_result convRes = std::from_chars(text.data() + pos, textEnd, number);
+				if (convRes.ec != std::errc())
+				{
+					return false;
+				}
+				pos = static_cast<size_t>(convRes.ptr - text.data());
+				return true;
+			};
+			auto skipSeparator = [&text, &pos](char separator) -> bool
+			{
+				if (pos < text.size() && text[pos] == separator)
+				{
+					pos++;
+					return true;
+				}
+				return false;
+			};
+			int textK = 0;
+			uint64_t textCount = 0;
+			double textMin = 0.0, textMax = 0.0;
+			if (!readNumber(textK) || !skipSeparator(';') ||
+				!readNumber(textCount) || !skipSeparator(';') ||
+				!readNumber(textMin) || !skipSeparator(';') ||
+				!readNumber(textMax) || textK < 8)
+			{
+				return false;
+			}
+			std::vector<std::vector<double>> textLevels;
+			while (skipSeparator(';'))
+			{
+				textLevels.emplace_back();
+				//empty level
+				if (pos >= text.size() || text[pos] == ';')
+				{
+					continue;
+				}
+				do
+				{
+					double item = 0.0;
+					if (!readNumber(item))
+					{
+						return false;
+					}
+					textLevels.back().push_back(item);
+				} while (skipSeparator(','));
+			}
+			if (pos != text.size() || textLevels.empty())
+			{
+				return false;
+			}
+			k = textK;
+			count = textCount;
+			minValue = textMin;
+			maxValue = textMax;
+			levels = std::move(textLevels);
+			return true;
+		}
+	};
+
+	//sketch of one sensor in one time window
+	struct SensorQuantileWindow
+	{
+		SensorHandle handle = INVALID_SENSOR_HANDLE;
+		//window start (aligned to duration) and duration, msec
+		int64_t startTimestamp = 0;
+		int64_t duration = 0;
+		SensorQuantileSketch sketch;
+	};
+
+	/* per sensor sketches of fixed time windows (e.g. 1 min) */
+	/* closed windows are queued for consumer (uploader) like SensorRollup buckets */
+	class SensorQuantiles
+	{
+	private:
+		int64_t windowDuration = 0;
+		int sketchAccuracy = 200;
+		//current windows, index = handle
+		std::vector<SensorQuantileWindow> openWindows = {};
+		std::vector<int64_t> lastTimestamps = {};
+		//closed windows stream
+		std::deque<SensorQuantileWindow> closedWindows = {};
+		size_t maxClosedWindows = 0;
+		//closed windows dropped from full output queue
+		uint64_t windowsDropped = 0;
+
+		void closeWindow(SensorHandle handle)
+		{
+			SensorQuantileWindow& window = openWindows[handle];
+			if (window.sketch.Count() == 0)
+			{
+				return;
+			}
+			if (maxClosedWindows > 0 && closedWindows.size() >= maxClosedWindows)
+			{
+				closedWindows.pop_front();
+				windowsDropped++;
+			}
+			closedWindows.push_back(window);
+			window.sketch.Clear();
+		}
+
+	public:
+		//duration - window duration, msec; accuracy - sketch k parameter
+		//maxQueuedWindows - output queue limit, oldest windows are dropped (0 - no limit)
+		SensorQuantiles(int64_t duration, int accuracy = 200, size_t maxQueuedWindows = 0) :
+			windowDuration(duration > 0 ? duration : 1), sketchAccuracy(accuracy), maxClosedWindows(maxQueuedWindows)
+		{
+		}
+		~SensorQuantiles()
+		{
+		}
+
+		//add sample of one sensor, timestamps must not decrease
+		void Append(SensorHandle handle, int64_t timestamp, double value)
+		{
+			if (handle < 0)
+			{
+				return;
+			}
+			if (static_cast<size_t>(handle) >= openWindows.size())
+			{
+				openWindows.resize(static_cast<size_t>(handle) + 1, { .sketch = SensorQuantileSketch(sketchAccuracy) });
+				lastTimestamps.resize(static_cast<size_t>(handle) + 1, 0);
+			}
+			SensorQuantileWindow& window = openWindows[handle];
+			int64_t windowStart = AlignSensorTimestamp(timestamp, windowDuration);
+			if (window.sketch.Count() > 0 && window.startTimestamp != windowStart)
+			{
+				closeWindow(handle);
+			}
+			if (window.sketch.Count() == 0)
+			{
+				window.handle = handle;
+				window.startTimestamp = windowStart;
+				window.duration = windowDuration;
+			}
+			window.sketch.Update(value);
+			lastTimestamps[handle] = timestamp;
+		}
+
+		//add samples of all sensors from snapshot which are newer than last added
+		void AppendSnapshot(const SensorSnapshot& snapshot)
+		{
+			for (size_t i = 0; i < snapshot.Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (snapshot.HasValue(handle) &&
+					(i >= lastTimestamps.size() || snapshot.Timestamp(handle) > lastTimestamps[i]))
+				{
+					Append(handle, snapshot.Timestamp(handle), snapshot.Value(handle));
+				}
+			}
+		}
+
+		//close windows which ended before timestamp (sensors without new samples)
+		void CloseExpired(int64_t timestamp)
+		{
+			for (size_t i = 0; i < openWindows.size(); i++)
+			{
+				if (openWindows[i].sketch.Count() > 0 && openWindows[i].startTimestamp + windowDuration <= timestamp)
+				{
+					closeWindow(static_cast<SensorHandle>(i));
+				}
+			}
+		}
+
+		//sketch of current window of sensor, nullptr if no samples
+		const SensorQuantileSketch* GetCurrent(SensorHandle handle) const
+		{
+			if (handle < 0 || static_cast<size_t>(handle) >= openWindows.size() || openWindows[handle].sketch.Count() == 0)
+			{
+				return nullptr;
+			}
+			return &openWindows[handle].sketch;
+		}
+
+		//take oldest closed window
+		bool PopClosedWindow(SensorQuantileWindow& window)
+		{
+			if (closedWindows.empty())
+			{
+				return false;
+			}
+			window = std::move(closedWindows.front());
+			closedWindows.pop_front();
+			return true;
+		}
+
+		size_t ClosedWindowsCount() const
+		{
+			return closedWindows.size();
+		}
+
+		uint64_t WindowsDropped() const
+		{
+			return windowsDropped;
+		}
+	};
+}
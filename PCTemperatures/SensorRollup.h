@@ -0,0 +1,257 @@
+//*********************************************************************************************************//
+//SensorRollup header file
+//Multi-resolution rollups of sensors samples (e.g. 1 min -> 1 hour buckets), closed buckets stream
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include "SensorTable.h"
+#include "SensorSnapshot.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//aggregated samples of one sensor in one time bucket
+	struct SensorRollupBucket
+	{
+		SensorHandle handle = INVALID_SENSOR_HANDLE;
+		//rollup level (index of duration)
+		size_t level = 0;
+		//bucket start (aligned to duration) and duration, msec
+		int64_t startTimestamp = 0;
+		int64_t duration = 0;
+		size_t count = 0;
+		double minValue = 0.0;
+		double maxValue = 0.0;
+		double sum = 0.0;
+		double lastValue = 0.0;
+		int64_t lastTimestamp = 0;
+
+		double Mean() const
+		{
+			return count > 0 ? sum / static_cast<double>(count) : 0.0;
+		}
+	};
+
+	//rollup counters
+	struct SensorRollupStats
+	{
+		uint64_t samplesAdded = 0;
+		uint64_t bucketsClosed = 0;
+		//closed buckets dropped from full output queue (consumer too slow)
+		uint64_t bucketsDropped = 0;
+	};
+
+	//bucket as compact JSON text (for upload as one database node)
+	inline std::string FormatRollupBucket(const SensorRollupBucket& bucket)
+	{
+		return "{\"min\":" + std::to_string(bucket.minValue) +
+			",\"max\":" + std::to_string(bucket.maxValue) +
+			",\"mean\":" + std::to_string(bucket.Mean()) +
+			",\"count\":" + std::to_string(bucket.count) +
+			",\"last\":" + std::to_string(bucket.lastValue) + "}";
+	}
+
+	/* rollup engine */
+	/* level 0 buckets are filled by raw samples, level N - by closed buckets of level N - 1 */
+	/* (durations must be multiples of previous level), raw samples are not stored here - see SensorHistory */
+	/* closed buckets of all levels are queued in order of closing and taken by consumer (uploader) */
+	class SensorRollup
+	{
+	private:
+		//bucket durations of levels, msec
+		std::vector<int64_t> levels = {};
+		//open buckets: [handle * levels count + level], count = 0 - no open bucket
+		std::vector<SensorRollupBucket> openBuckets = {};
+		//timestamp of last added raw sample of every sensor
+		std::vector<int64_t> lastTimestamps = {};
+		size_t sensorsCount = 0;
+		//closed buckets stream
+		std::deque<SensorRollupBucket> closedBuckets = {};
+		size_t maxClosedBuckets = 0;
+		SensorRollupStats stats = {};
+
+		//allocate open buckets for new sensors
+		void reserveSensor(SensorHandle handle)
+		{
+			if (static_cast<size_t>(handle) < sensorsCount)
+			{
+				return;
+			}
+			sensorsCount = static_cast<size_t>(handle) + 1;
+			openBuckets.resize(sensorsCount * levels.size());
+			lastTimestamps.resize(sensorsCount, std::numeric_limits<int64_t>::min());
+		}
+
+		//merge samples of source (sample or lower level bucket) into open bucket of level
+		void addToLevel(SensorHandle handle, size_t level, const SensorRollupBucket& source)
+		{
+			SensorRollupBucket& bucket = openBuckets[static_cast<size_t>(handle) * levels.size() + level];
+			int64_t bucketStart = AlignSensorTimestamp(source.startTimestamp, levels[level]);
+			//source belongs to next bucket - close current
+			if (bucket.count > 0 && bucket.startTimestamp != bucketStart)
+			{
+				closeBucket(handle, level);
+			}
+			if (bucket.count == 0)
+			{
+				bucket.handle = handle;
+				bucket.level = level;
+				bucket.startTimestamp = bucketStart;
+				bucket.duration = levels[level];
+				bucket.minValue = source.minValue;
+				bucket.maxValue = source.maxValue;
+				bucket.sum = 0.0;
+			}
+			bucket.count += source.count;
+			bucket.minValue = source.minValue < bucket.minValue ? source.minValue : bucket.minValue;
+			bucket.maxValue = source.maxValue > bucket.maxValue ? source.maxValue : bucket.maxValue;
+			bucket.sum += source.sum;
+			bucket.lastValue = source.lastValue;
+			bucket.lastTimestamp = source.lastTimestamp;
+		}
+
+		//move open bucket to output stream and pass it to next level
+		void closeBucket(SensorHandle handle, size_t level)
+		{
+			SensorRollupBucket& bucket = openBuckets[static_cast<size_t>(handle) * levels.size() + level];
+			if (bucket.count == 0)
+			{
+				return;
+			}
+			SensorRollupBucket closedBucket = bucket;
+			bucket.count = 0;
+			if (maxClosedBuckets > 0 && closedBuckets.size() >= maxClosedBuckets)
+			{
+				closedBuckets.pop_front();
+				stats.bucketsDropped++;
+			}
+			closedBuckets.push_back(closedBucket);
+			stats.bucketsClosed++;
+			if (level + 1 < levels.size())
+			{
+				addToLevel(handle, level + 1, closedBucket);
+			}
+		}
+
+	public:
+		//levelDurations - bucket durations, msec (e.g. 1 min, 1 hour)
+		//maxQueuedBuckets - output queue limit, oldest buckets are dropped (0 - no limit)
+		SensorRollup(const std::vector<int64_t>& levelDurations, size_t maxQueuedBuckets = 0) :
+			levels(levelDurations), maxClosedBuckets(maxQueuedBuckets)
+		{
+			for (int64_t& duration : levels)
+			{
+				duration = duration > 0 ? duration : 1;
+			}
+		}
+		~SensorRollup()
+		{
+		}
+
+		//add raw sample of one sensor, timestamps must not decrease
+		void Append(SensorHandle handle, int64_t timestamp, double value)
+		{
+			if (handle < 0 || levels.empty())
+			{
+				return;
+			}
+			reserveSensor(handle);
+			SensorRollupBucket sample;
+			sample.startTimestamp = timestamp;
+			sample.count = 1;
+			sample.minValue = value;
+			sample.maxValue = value;
+			sample.sum = value;
+			sample.lastValue = value;
+			sample.lastTimestamp = timestamp;
+			addToLevel(handle, 0, sample);
+			lastTimestamps[handle] = timestamp;
+			stats.samplesAdded++;
+		}
+
+		//add samples of all sensors from snapshot which are newer than last added
+		void AppendSnapshot(const SensorSnapshot& snapshot)
+		{
+			for (size_t i = 0; i < snapshot.Size(); i++)
+			{
+				SensorHandle handle = static_cast<SensorHandle>(i);
+				if (snapshot.HasValue(handle) &&
+					(static_cast<size_t>(handle) >= sensorsCount || snapshot.Timestamp(handle) > lastTimestamps[handle]))
+				{
+					Append(handle, snapshot.Timestamp(handle), snapshot.Value(handle));
+				}
+			}
+		}
+
+		//close buckets which ended before timestamp (sensors without new samples), all levels
+		void CloseExpired(int64_t timestamp)
+		{
+			for (size_t level = 0; level < levels.size(); level++)
+			{
+				for (size_t i = 0; i < sensorsCount; i++)
+				{
+					const SensorRollupBucket& bucket = openBuckets[i * levels.size() + level];
+					if (bucket.count > 0 && bucket.startTimestamp + bucket.duration <= timestamp)
+					{
+						closeBucket(static_cast<SensorHandle>(i), level);
+					}
+				}
+			}
+		}
+
+		//take oldest closed bucket from stream
+		bool PopClosedBucket(SensorRollupBucket& bucket)
+		{
+			if (closedBuckets.empty())
+			{
+				return false;
+			}
+			bucket = closedBuckets.front();
+			closedBuckets.pop_front();
+			return true;
+		}
+
+		size_t ClosedBucketsCount() const
+		{
+			return closedBuckets.size();
+		}
+
+		//current (not closed) bucket of sensor
+		bool GetOpenBucket(SensorHandle handle, size_t level, SensorRollupBucket& bucket) const
+		{
+			if (handle < 0 || static_cast<size_t>(handle) >= sensorsCount || level >= levels.size())
+			{
+				return false;
+			}
+			const SensorRollupBucket& openBucket = openBuckets[static_cast<size_t>(handle) * levels.size() + level];
+			if (openBucket.count == 0)
+			{
+				return false;
+			}
+			bucket = openBucket;
+			return true;
+		}
+
+		size_t LevelsCount() const
+		{
+			return levels.size();
+		}
+
+		int64_t LevelDuration(size_t level) const
+		{
+			return levels[level];
+		}
+
+		const SensorRollupStats& GetStats() const
+		{
+			return stats;
+		}
+	};
+}
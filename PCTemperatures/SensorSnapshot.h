@@ -0,0 +1,268 @@
+//*********************************************************************************************************//
+//SensorSnapshot header file
+//Immutable reference-counted sets of sensors samples, published by scanner after each update
+//Publication is RCU-style: writer fills private snapshot and swaps pointer, readers never block
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <span>
+#include <atomic>
+#include <cstdint>
+#include "SensorTable.h"
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	/* immutable samples of all sensors for one update */
+	/* index = sensor handle, metadata list is shared between snapshots until new sensor discovery */
+	class SensorSnapshot
+	{
+		friend class SensorSnapshotPublisher;
+		friend class SensorSnapshotRef;
+
+	private:
+		std::vector<double> values = {};
+		std::vector<int64_t> timestamps = {};
+		std::vector<uint8_t> flags = {};
+		std::shared_ptr<const std::vector<SensorRecord>> info = nullptr;
+		//publication number, increases with every update
+		uint64_t generation = 0;
+		//sensors table metadata generation of info list
+		uint64_t infoGeneration = 0;
+		//number of references held by readers, snapshot is reused by writer only when zero
+		mutable std::atomic<int> readersCount = 0;
+
+	public:
+		SensorSnapshot()
+		{
+		}
+		~SensorSnapshot()
+		{
+		}
+
+		//number of handles
+		size_t Size() const
+		{
+			return values.size();
+		}
+
+		uint64_t Generation() const
+		{
+			return generation;
+		}
+
+		//changes only with sensors metadata (new sensor, label, kind...)
+		uint64_t InfoGeneration() const
+		{
+			return infoGeneration;
+		}
+
+		//active sensor with value
+		bool HasValue(SensorHandle handle) const
+		{
+			return handle >= 0 && static_cast<size_t>(handle) < values.size() &&
+				(flags[handle] & (SENSOR_FLAG_ACTIVE | SENSOR_FLAG_VALID)) == (SENSOR_FLAG_ACTIVE | SENSOR_FLAG_VALID);
+		}
+
+		double Value(SensorHandle handle) const
+		{
+			return values[handle];
+		}
+
+		int64_t Timestamp(SensorHandle handle) const
+		{
+			return timestamps[handle];
+		}
+
+		uint8_t Flags(SensorHandle handle) const
+		{
+			return flags[handle];
+		}
+
+		const SensorRecord& Info(SensorHandle handle) const
+		{
+			return (*info)[handle];
+		}
+
+		const std::string& Name(SensorHandle handle) const
+		{
+			return (*info)[handle].name;
+		}
+
+		//contiguous arrays for linear scans
+		std::span<const double> Values() const
+		{
+			return values;
+		}
+
+		std::span<const int64_t> Timestamps() const
+		{
+			return timestamps;
+		}
+
+		std::span<const uint8_t> FlagsData() const
+		{
+			return flags;
+		}
+	};
+
+	/* reference to published snapshot, snapshot stays valid while reference exists */
+	/* references must not outlive scanner object (publisher) */
+	class SensorSnapshotRef
+	{
+		friend class SensorSnapshotPublisher;
+
+	private:
+		const SensorSnapshot* snapshot = nullptr;
+
+		//snapshot already pinned by publisher
+		explicit SensorSnapshotRef(const SensorSnapshot* pinnedSnapshot) : snapshot(pinnedSnapshot)
+		{
+		}
+
+	public:
+		SensorSnapshotRef()
+		{
+		}
+		SensorSnapshotRef(const SensorSnapshotRef& other) : snapshot(other.snapshot)
+		{
+			if (snapshot != nullptr)
+			{
+				snapshot->readersCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		SensorSnapshotRef(SensorSnapshotRef&& other) noexcept : snapshot(other.snapshot)
+		{
+			other.snapshot = nullptr;
+		}
+		SensorSnapshotRef& operator=(SensorSnapshotRef other) noexcept
+		{
+			std::swap(snapshot, other.snapshot);
+			return *this;
+		}
+		~SensorSnapshotRef()
+		{
+			reset();
+		}
+
+		const SensorSnapshot* get() const
+		{
+			return snapshot;
+		}
+
+		const SensorSnapshot* operator->() const
+		{
+			return snapshot;
+		}
+
+		const SensorSnapshot& operator*() const
+		{
+			return *snapshot;
+		}
+
+		explicit operator bool() const
+		{
+			return snapshot != nullptr;
+		}
+
+		void reset()
+		{
+			if (snapshot != nullptr)
+			{
+				//reads of snapshot data happen before writer reuses it
+				snapshot->readersCount.fetch_sub(1, std::memory_order_release);
+				snapshot = nullptr;
+			}
+		}
+	};
+
+	/* publisher: fills snapshot from sensors table and makes it current */
+	/* one writer thread (Publish), any number of reader threads (GetCurrent) */
+	/* snapshots released by all readers are reused, steady state publication has no allocations */
+	class SensorSnapshotPublisher
+	{
+	private:
+		//all snapshots: current, held by readers and free (changed by writer only, readers never access pool)
+		std::vector<std::unique_ptr<SensorSnapshot>> snapshotsPool = {};
+		std::atomic<SensorSnapshot*> currentSnapshot = nullptr;
+		//shared metadata list and table generation it was built from
+		std::shared_ptr<const std::vector<SensorRecord>> infoList = nullptr;
+		uint64_t infoGeneration = 0;
+		uint64_t publishGeneration = 0;
+
+		//snapshot not current and not pinned by readers
+		SensorSnapshot* getFreeSnapshot()
+		{
+			SensorSnapshot* current = currentSnapshot.load(std::memory_order_relaxed);
+			for (std::unique_ptr<SensorSnapshot>& snapshot : snapshotsPool)
+			{
+				//seq_cst pairs with reader pin/validate, acquire - with reader release
+				if (snapshot.get() != current && snapshot->readersCount.load(std::memory_order_seq_cst) == 0)
+				{
+					return snapshot.get();
+				}
+			}
+			snapshotsPool.push_back(std::make_unique<SensorSnapshot>());
+			return snapshotsPool.back().get();
+		}
+
+	public:
+		SensorSnapshotPublisher()
+		{
+		}
+		~SensorSnapshotPublisher()
+		{
+		}
+		SensorSnapshotPublisher(const SensorSnapshotPublisher&) = delete;
+		SensorSnapshotPublisher& operator=(const SensorSnapshotPublisher&) = delete;
+
+		//copy table samples to free snapshot and atomically make it current (writer thread)
+		void Publish(const SensorTable& table)
+		{
+			if (infoList == nullptr || table.InfoGeneration() != infoGeneration)
+			{
+				infoList = std::make_shared<const std::vector<SensorRecord>>(table.InfoList());
+				infoGeneration = table.InfoGeneration();
+			}
+
+			SensorSnapshot* snapshot = getFreeSnapshot();
+			snapshot->values.assign(table.Values(), table.Values() + table.Size());
+			snapshot->timestamps.assign(table.Timestamps(), table.Timestamps() + table.Size());
+			snapshot->flags.assign(table.FlagsData(), table.FlagsData() + table.Size());
+			snapshot->info = infoList;
+			snapshot->infoGeneration = infoGeneration;
+			snapshot->generation = ++publishGeneration;
+			currentSnapshot.store(snapshot, std::memory_order_seq_cst);
+		}
+
+		//reference to current snapshot, empty if nothing published (any thread, lock-free)
+		SensorSnapshotRef GetCurrent() const
+		{
+			while (true)
+			{
+				SensorSnapshot* snapshot = currentSnapshot.load(std::memory_order_seq_cst);
+				if (snapshot == nullptr)
+				{
+					return SensorSnapshotRef();
+				}
+				//pin and check that snapshot is still current - writer could take it for reuse before pin
+				snapshot->readersCount.fetch_add(1, std::memory_order_seq_cst);
+				if (currentSnapshot.load(std::memory_order_seq_cst) == snapshot)
+				{
+					return SensorSnapshotRef(snapshot);
+				}
+				snapshot->readersCount.fetch_sub(1, std::memory_order_release);
+			}
+		}
+
+		//number of allocated snapshots (current, pinned by readers and free)
+		size_t PoolSize() const
+		{
+			return snapshotsPool.size();
+		}
+	};
+}
@@ -0,0 +1,253 @@
+//*********************************************************************************************************//
+//SensorTable header file
+//Flat sensors table: dense arrays of values, timestamps and flags indexed by small integer handles
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	//kind of sensor value
+	enum class SensorKind
+	{
+		SENSOR_KIND_OTHER = 0,
+		SENSOR_KIND_TEMPERATURE,
+		SENSOR_KIND_CLOCK,
+		SENSOR_KIND_LOAD,
+		SENSOR_KIND_FAN,
+		SENSOR_KIND_POWER,
+		SENSOR_KIND_VOLTAGE,
+		SENSOR_KIND_CURRENT
+	};
+
+	//sensor kinds bit mask, for include filters
+	constexpr unsigned SensorKindMask(SensorKind kind)
+	{
+		return 1u << static_cast<unsigned>(kind);
+	}
+	constexpr unsigned SENSOR_KIND_MASK_ALL = 0xFFFFFFFFu;
+
+	//typed sensor record
+	struct SensorRecord
+	{
+		//unique key of sensor in source
+		std::string name = "";
+		//display label (can be localized and not unique)
+		std::string label = "";
+		SensorKind kind = SensorKind::SENSOR_KIND_OTHER;
+		std::string unit = "";
+		//number of significant digits after decimal point
+		int digits = 0;
+		double value = 0.0;
+		//data source tag (provider name in aggregated sets)
+		std::string source = "";
+	};
+
+	//sensor handle - index in sensors table, stable for table lifetime
+	typedef int SensorHandle;
+	constexpr SensorHandle INVALID_SENSOR_HANDLE = -1;
+
+	//sensor flags
+	constexpr uint8_t SENSOR_FLAG_ACTIVE = 0x01;	//sensor present in source
+	constexpr uint8_t SENSOR_FLAG_VALID = 0x02;		//value was set at least once
+
+	//sample timestamp, msec since epoch
+	inline int64_t SensorTimestampNow()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	//start of time bucket of timestamp (buckets of duration from epoch, timestamps before epoch too)
+	inline int64_t AlignSensorTimestamp(int64_t timestamp, int64_t duration)
+	{
+		int64_t rem = timestamp % duration;
+		return rem < 0 ? timestamp - rem - duration : timestamp - rem;
+	}
+
+	/* sensors table */
+	/* name -> handle dictionary used only on discovery, values access by handle */
+	class SensorTable
+	{
+	private:
+		//dense per-sensor arrays, index = handle
+		std::vector<double> values = {};
+		std::vector<int64_t> timestamps = {};
+		std::vector<uint8_t> flags = {};
+		//metadata, set on discovery
+		std::vector<SensorRecord> info = {};
+		//name -> handle
+		std::unordered_map<std::string, SensorHandle> handles = {};
+		size_t activeCount = 0;
+		//incremented on every metadata change (new sensor or changed info)
+		uint64_t infoGeneration = 0;
+
+	public:
+		SensorTable()
+		{
+		}
+		~SensorTable()
+		{
+		}
+
+		//find or add sensor by name and mark active, handle of removed sensor is reused
+		SensorHandle Register(const std::string& name)
+		{
+			SensorHandle handle = Find(name);
+			if (handle == INVALID_SENSOR_HANDLE)
+			{
+				handle = static_cast<SensorHandle>(values.size());
+				values.push_back(0.0);
+				timestamps.push_back(0);
+				flags.push_back(0);
+				info.emplace_back();
+				info.back().name = name;
+				info.back().label = name;
+				handles[name] = handle;
+				infoGeneration++;
+			}
+			if ((flags[handle] & SENSOR_FLAG_ACTIVE) == 0)
+			{
+				flags[handle] |= SENSOR_FLAG_ACTIVE;
+				activeCount++;
+			}
+			return handle;
+		}
+
+		//set sensor metadata
+		void SetInfo(SensorHandle handle, const std::string& label, SensorKind kind, const std::string& unit, int digits)
+		{
+			if (info[handle].label == label &&
+				info[handle].kind == kind &&
+				info[handle].unit == unit &&
+				info[handle].digits == digits)
+			{
+				return;
+			}
+			infoGeneration++;
+			info[handle].label = label;
+			info[handle].kind = kind;
+			info[handle].unit = unit;
+			info[handle].digits = digits;
+		}
+
+		//set sensor data source tag
+		void SetSource(SensorHandle handle, const std::string& source)
+		{
+			if (info[handle].source == source)
+			{
+				return;
+			}
+			infoGeneration++;
+			info[handle].source = source;
+		}
+
+		//sensor not present in source anymore, handle stays reserved for this name
+		void Deactivate(SensorHandle handle)
+		{
+			if ((flags[handle] & SENSOR_FLAG_ACTIVE) != 0)
+			{
+				flags[handle] = 0;
+				activeCount--;
+			}
+		}
+
+		//find sensor handle by name
+		SensorHandle Find(const std::string& name) const
+		{
+			std::unordered_map<std::string, SensorHandle>::const_iterator findedEl = handles.find(name);
+			return findedEl != handles.end() ? findedEl->second : INVALID_SENSOR_HANDLE;
+		}
+
+		//set sensor value (no allocations)
+		void SetValue(SensorHandle handle, double value, int64_t timestamp)
+		{
+			values[handle] = value;
+			timestamps[handle] = timestamp;
+			flags[handle] |= SENSOR_FLAG_VALID;
+		}
+
+		//number of handles (active and removed sensors)
+		size_t Size() const
+		{
+			return values.size();
+		}
+
+		//number of active sensors
+		size_t ActiveCount() const
+		{
+			return activeCount;
+		}
+
+		bool IsValidHandle(SensorHandle handle) const
+		{
+			return handle >= 0 && static_cast<size_t>(handle) < values.size();
+		}
+
+		//active sensor with value
+		bool HasValue(SensorHandle handle) const
+		{
+			return IsValidHandle(handle) && (flags[handle] & (SENSOR_FLAG_ACTIVE | SENSOR_FLAG_VALID)) == (SENSOR_FLAG_ACTIVE | SENSOR_FLAG_VALID);
+		}
+
+		double Value(SensorHandle handle) const
+		{
+			return values[handle];
+		}
+
+		int64_t Timestamp(SensorHandle handle) const
+		{
+			return timestamps[handle];
+		}
+
+		uint8_t Flags(SensorHandle handle) const
+		{
+			return flags[handle];
+		}
+
+		const SensorRecord& Info(SensorHandle handle) const
+		{
+			return info[handle];
+		}
+
+		const std::string& Name(SensorHandle handle) const
+		{
+			return info[handle].name;
+		}
+
+		//all sensors metadata, index = handle
+		const std::vector<SensorRecord>& InfoList() const
+		{
+			return info;
+		}
+
+		uint64_t InfoGeneration() const
+		{
+			return infoGeneration;
+		}
+
+		//contiguous arrays for linear scans, size = Size()
+		const double* Values() const
+		{
+			return values.data();
+		}
+
+		const int64_t* Timestamps() const
+		{
+			return timestamps.data();
+		}
+
+		const uint8_t* FlagsData() const
+		{
+			return flags.data();
+		}
+	};
+}
@@ -0,0 +1,352 @@
+//*********************************************************************************************************//
+//SharedMemoryView header file
+//Platform layer for access to named shared memory blocks (Win32 file mapping or POSIX shm_open/mmap)
+//and memory-mapped files
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/* separate namespace */
+namespace PCTemperaturesScanner
+{
+	/* mapped view of named shared memory */
+	/* one object - one view, view stays mapped until Close() or destruction */
+	class SharedMemoryView
+	{
+	private:
+#ifdef _WIN32
+		HANDLE hMapFile = NULL;
+		//mapped disk file (OpenFile)
+		HANDLE hFile = INVALID_HANDLE_VALUE;
+#else
+		//POSIX shm name (with leading slash), used by Create for unlink on close
+		std::string shmName = "";
+		bool shmOwner = false;
+#endif
+		void* viewPtr = nullptr;
+		size_t viewSize = 0;
+		//last platform error code (GetLastError() or errno)
+		int lastError = 0;
+
+		//map already opened/created object, size = 0 - map whole object
+		//shmFd - POSIX object descriptor (not used for Win32)
+		bool mapView(bool writeAccess, size_t size, int shmFd = -1)
+		{
+#ifdef _WIN32
+			(void)shmFd;
+			viewPtr = MapViewOfFile(hMapFile, // handle to map object
+				writeAccess ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ,
+				0,
+				0,
+				size);
+			if (viewPtr == NULL)
+			{
+				lastError = static_cast<int>(GetLastError());
+				return false;
+			}
+			if (size == 0)
+			{
+				//real size of whole object
+				MEMORY_BASIC_INFORMATION memInfo = {};
+				if (VirtualQuery(viewPtr, &memInfo, sizeof(memInfo)) == 0)
+				{
+					lastError = static_cast<int>(GetLastError());
+					return false;
+				}
+				size = memInfo.RegionSize;
+			}
+#else
+			struct stat shmStat = {};
+			if (fstat(shmFd, &shmStat) != 0)
+			{
+				lastError = errno;
+				return false;
+			}
+			if (size == 0)
+			{
+				size = static_cast<size_t>(shmStat.st_size);
+			}
+			//producer has not sized the object yet (or too small)
+			if (size == 0 || static_cast<size_t>(shmStat.st_size) < size)
+			{
+				lastError = EINVAL;
+				return false;
+			}
+			void* mapPtr = mmap(nullptr, size, writeAccess ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, shmFd, 0);
+			if (mapPtr == MAP_FAILED)
+			{
+				lastError = errno;
+				return false;
+			}
+			viewPtr = mapPtr;
+#endif
+			viewSize = size;
+			return true;
+		}
+
+	public:
+		SharedMemoryView()
+		{
+		}
+		~SharedMemoryView()
+		{
+			Close();
+		}
+		SharedMemoryView(const SharedMemoryView&) = delete;
+		SharedMemoryView& operator=(const SharedMemoryView&) = delete;
+
+		//open existing named object (created by producer) and map view
+		//size = 0 - map whole object
+		bool Open(const std::string& name, size_t size, bool writeAccess = false)
+		{
+			Close();
+#ifdef _WIN32
+			hMapFile = OpenFileMappingA(
+				writeAccess ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ,
+				FALSE, // do not inherit the name
+				name.c_str()); // name of mapping object
+			if (hMapFile == NULL)
+			{
+				lastError = static_cast<int>(GetLastError());
+				return false;
+			}
+			if (!mapView(writeAccess, size))
+			{
+				Close();
+				return false;
+			}
+#else
+			int shmFd = shm_open(("/" + name).c_str(), writeAccess ? O_RDWR : O_RDONLY, 0);
+			if (shmFd < 0)
+			{
+				lastError = errno;
+				return false;
+			}
+			bool mapRes = mapView(writeAccess, size, shmFd);
+			//view keeps object alive, descriptor not needed anymore
+			close(shmFd);
+			if (!mapRes)
+			{
+				Close();
+				return false;
+			}
+#endif
+			return true;
+		}
+
+		//create named object with read/write view (producer side, e.g. synthetic data source)
+		bool Create(const std::string& name, size_t size)
+		{
+			Close();
+			if (size == 0)
+			{
+				return false;
+			}
+#ifdef _WIN32
+			hMapFile = CreateFileMappingA(INVALID_HANDLE_VALUE,
+				NULL,
+				PAGE_READWRITE,
+				static_cast<DWORD>(static_cast<unsigned long long>(size) >> 32),
+				static_cast<DWORD>(size & 0xFFFFFFFF),
+				name.c_str());
+			if (hMapFile == NULL)
+			{
+				lastError = static_cast<int>(GetLastError());
+				return false;
+			}
+			if (!mapView(true, size))
+			{
+				Close();
+				return false;
+			}
+#else
+			shmName = "/" + name;
+			int shmFd = shm_open(shmName.c_str(), O_RDWR | O_CREAT, 0644);
+			if (shmFd < 0)
+			{
+				lastError = errno;
+				shmName = "";
+				return false;
+			}
+			shmOwner = true;
+			if (ftruncate(shmFd, static_cast<off_t>(size)) != 0)
+			{
+				lastError = errno;
+				close(shmFd);
+				Close();
+				return false;
+			}
+			bool mapRes = mapView(true, size, shmFd);
+			close(shmFd);
+			if (!mapRes)
+			{
+				Close();
+				return false;
+			}
+#endif
+			return true;
+		}
+
+		//open or create disk file with read/write view, file is extended to size if smaller
+		//data written to view is saved to file by system (see Flush), file survives process restart
+		bool OpenFile(const std::string& path, size_t size)
+		{
+			Close();
+			if (size == 0)
+			{
+				return false;
+			}
+#ifdef _WIN32
+			hFile = CreateFileA(path.c_str(),
+				GENERIC_READ | GENERIC_WRITE,
+				FILE_SHARE_READ,
+				NULL,
+				OPEN_ALWAYS,
+				FILE_ATTRIBUTE_NORMAL,
+				NULL);
+			if (hFile == INVALID_HANDLE_VALUE)
+			{
+				lastError = static_cast<int>(GetLastError());
+				return false;
+			}
+			hMapFile = CreateFileMappingA(hFile,
+				NULL,
+				PAGE_READWRITE,
+				static_cast<DWORD>(static_cast<unsigned long long>(size) >> 32),
+				static_cast<DWORD>(size & 0xFFFFFFFF),
+				NULL);
+			if (hMapFile == NULL)
+			{
+				lastError = static_cast<int>(GetLastError());
+				Close();
+				return false;
+			}
+			if (!mapView(true, size))
+			{
+				Close();
+				return false;
+			}
+#else
+			int fileFd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+			if (fileFd < 0)
+			{
+				lastError = errno;
+				return false;
+			}
+			struct stat fileStat = {};
+			if (fstat(fileFd, &fileStat) != 0 ||
+				(static_cast<size_t>(fileStat.st_size) < size && ftruncate(fileFd, static_cast<off_t>(size)) != 0))
+			{
+				lastError = errno;
+				close(fileFd);
+				return false;
+			}
+			bool mapRes = mapView(true, size, fileFd);
+			close(fileFd);
+			if (!mapRes)
+			{
+				Close();
+				return false;
+			}
+#endif
+			return true;
+		}
+
+		//start writing of changed pages of mapped file to disk (not waiting)
+		bool Flush()
+		{
+			if (viewPtr == nullptr)
+			{
+				return false;
+			}
+#ifdef _WIN32
+			if (!FlushViewOfFile(viewPtr, 0))
+			{
+				lastError = static_cast<int>(GetLastError());
+				return false;
+			}
+#else
+			if (msync(viewPtr, viewSize, MS_ASYNC) != 0)
+			{
+				lastError = errno;
+				return false;
+			}
+#endif
+			return true;
+		}
+
+		//unmap view and release object
+		void Close()
+		{
+#ifdef _WIN32
+			if (viewPtr != nullptr)
+			{
+				UnmapViewOfFile(viewPtr);
+			}
+			if (hMapFile != NULL)
+			{
+				CloseHandle(hMapFile);
+				hMapFile = NULL;
+			}
+			if (hFile != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(hFile);
+				hFile = INVALID_HANDLE_VALUE;
+			}
+#else
+			if (viewPtr != nullptr)
+			{
+				munmap(viewPtr, viewSize);
+			}
+			//created object - remove name, like Win32 object destroyed with last handle
+			if (shmOwner)
+			{
+				shm_unlink(shmName.c_str());
+				shmOwner = false;
+			}
+			shmName = "";
+#endif
+			viewPtr = nullptr;
+			viewSize = 0;
+		}
+
+		bool IsOpen() const
+		{
+			return viewPtr != nullptr;
+		}
+
+		const void* Data() const
+		{
+			return viewPtr;
+		}
+
+		void* Data()
+		{
+			return viewPtr;
+		}
+
+		size_t Size() const
+		{
+			return viewSize;
+		}
+
+		int LastError() const
+		{
+			return lastError;
+		}
+	};
+}
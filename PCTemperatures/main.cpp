@@ -5,6 +5,7 @@
 //*********************************************************************************************************//
 
 #include "PCTemperaturesScanner.h"
+#include "SensorAggregator.h"
 #include <map>
 
 int main(int argc, char* argv[])
@@ -21,6 +22,13 @@ int main(int argc, char* argv[])
 	std::map<std::string, double> temperValuesAIDA64{};
 	aida64Temper.GetTemperatures(temperValuesAIDA64);
 
+	//get from all sources concurrently
+	PCTemperaturesScanner::SensorAggregator allTemper;
+	allTemper.AddProviders(PCTemperaturesScanner::SensorProviderRegistry::CreateDefault());
+	allTemper.UpdateTemperatures();
+	std::map<std::string, double> temperValuesAll{};
+	allTemper.GetTemperatures(temperValuesAll);
+
 	system("pause");
 
 	return 0;
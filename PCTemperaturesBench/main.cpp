@@ -0,0 +1,740 @@
+//*********************************************************************************************************//
+//TEST: PC temperatures scanner benchmarks (synthetic sources, without GPU-Z and AIDA64)
+//Created 17.10.2026
+//*********************************************************************************************************//
+
+#include "PCTemperaturesScanner.h"
+#include "AIDA64SensorsParser.h"
+#include "SensorSnapshot.h"
+#include "SensorCompressedHistory.h"
+#include "SensorQuantileSketch.h"
+#include "SensorDeadband.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <string_view>
+#include <algorithm>
+#include <map>
+#include <cstdlib>
+#include <regex>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <random>
+#include <cmath>
+#include <cstring>
+
+using namespace PCTemperaturesScanner;
+
+//*********************************************************************************************************//
+/* GPU-Z synthetic producer: published GPUZShMem layout, like GPU-Z writes it */
+#pragma pack(push, 1)
+struct gpuzRecord
+{
+	WCHAR key[256];
+	WCHAR value[256];
+};
+
+struct gpuzSensorRecord
+{
+	WCHAR name[256];
+	WCHAR unit[8];
+	UINT32 digits;
+	double value;
+};
+
+struct gpuzSharedMemory
+{
+	UINT32 version;
+	volatile LONG busy;
+	UINT32 lastUpdate;
+	gpuzRecord data[128];
+	gpuzSensorRecord sensors[128];
+};
+#pragma pack(pop)
+
+//copy wide string to fixed size field (null terminated)
+static void copyWideField(WCHAR* field, size_t fieldSize, std::wstring_view text)
+{
+	size_t textSize = std::min(text.size(), fieldSize - 1);
+	std::copy_n(text.data(), textSize, field);
+	field[textSize] = 0;
+}
+
+//create GPUZShMem with typical sensors set (~20 sensors, 4 temperatures)
+static bool createGPUZProducer(SharedMemoryView& producerView)
+{
+	if (!producerView.Create("GPUZShMem", sizeof(gpuzSharedMemory)))
+	{
+		std::cout << "Can't create GPUZShMem, error = " << producerView.LastError() << std::endl;
+		return false;
+	}
+	gpuzSharedMemory* shMem = static_cast<gpuzSharedMemory*>(producerView.Data());
+	shMem->version = 1;
+	const wchar_t* sensorNames[][2] =
+	{
+		{L"GPU Clock", L"MHz"}, {L"Memory Clock", L"MHz"}, {L"GPU Temperature", L"\xB0" L"C"}, {L"Hot Spot", L"\xB0" L"C"},
+		{L"Memory Temperature", L"\xB0" L"C"}, {L"Fan Speed (%)", L"%"}, {L"Fan Speed (RPM)", L"RPM"}, {L"Memory Used", L"MB"},
+		{L"GPU Load", L"%"}, {L"Memory Controller Load", L"%"}, {L"Video Engine Load", L"%"}, {L"Bus Interface Load", L"%"},
+		{L"Board Power Draw", L"W"}, {L"GPU Chip Power Draw", L"W"}, {L"PWR_SRC Power Draw", L"W"}, {L"PerfCap Reason", L""},
+		{L"GPU Voltage", L"V"}, {L"CPU Temperature", L"\xB0" L"C"}, {L"System Memory Used", L"MB"}, {L"Power Consumption (%)", L"%"}
+	};
+	int slot = 0;
+	for (const auto& sensorName : sensorNames)
+	{
+		copyWideField(shMem->sensors[slot].name, 256, sensorName[0]);
+		copyWideField(shMem->sensors[slot].unit, 8, sensorName[1]);
+		shMem->sensors[slot].digits = 1;
+		shMem->sensors[slot].value = 40.0 + slot;
+		slot++;
+	}
+	copyWideField(shMem->data[0].key, 256, L"CardName");
+	copyWideField(shMem->data[0].value, 256, L"Synthetic GPU");
+	return true;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* GPU-Z reader poll cost: open/map/copy/close per poll vs persistent view */
+/* changedEvery - producer publishes new data every N polls (1 - every poll) */
+static void benchGPUZAttach(GPUZAttachMode attachMode, int pollsCount, int changedEvery)
+{
+	SharedMemoryView producerView;
+	if (!createGPUZProducer(producerView))
+	{
+		return;
+	}
+	gpuzSharedMemory* shMem = static_cast<gpuzSharedMemory*>(producerView.Data());
+
+	GPUZTemperatures gpuzTemper(attachMode);
+	//first poll: attach and layout scan
+	gpuzTemper.UpdateTemperatures();
+	gpuzTemper.ResetReadStats();
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	int failedPolls = 0;
+	for (int i = 0; i < pollsCount; i++)
+	{
+		if (i % changedEvery == 0)
+		{
+			shMem->lastUpdate++;
+			shMem->sensors[2].value = 50.0 + (i % 20) * 0.5;
+		}
+		if (!gpuzTemper.UpdateTemperatures())
+		{
+			failedPolls++;
+		}
+	}
+	double elapsedNsec = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::map<std::string, double> temperValues{};
+	gpuzTemper.GetTemperatures(temperValues);
+	const GPUZReadStats& readStats = gpuzTemper.GetReadStats();
+	std::cout << "GPU-Z attach " << (attachMode == GPUZAttachMode::GPUZ_ATTACH_PERSISTENT ? "persistent" : "per poll  ") <<
+		", new data every " << changedEvery << " polls" <<
+		": " << static_cast<uint64_t>(elapsedNsec / pollsCount) << " ns/poll" <<
+		", skipped " << readStats.pollsSkipped << "/" << readStats.pollsTotal <<
+		", failed " << failedPolls <<
+		", temperatures " << temperValues.size() << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* AIDA64 sensors block like recorded from desktop (AIDA64_SensorValues), ~70 items */
+/* labelPadding - extra label text per item (larger block with same values) */
+static std::string makeAIDA64Payload(int sampleIndex, size_t labelPadding)
+{
+	struct aidaItem
+	{
+		const char* category;
+		const char* id;
+		const char* label;
+		double value;
+	};
+	static const aidaItem items[] =
+	{
+		{"sys", "SCPUCLK", "CPU Clock", 4389}, {"sys", "SCPUMUL", "CPU Multiplier", 44}, {"sys", "SCPUFSB", "CPU FSB", 99.8},
+		{"sys", "SMEMCLK", "Memory Clock", 1596}, {"sys", "SCPUUTI", "CPU Utilization", 7}, {"sys", "SMEMUTI", "Memory Utilization", 41},
+		{"sys", "SUSEDMEM", "Used Memory", 13287}, {"sys", "SFREEMEM", "Free Memory", 19263}, {"sys", "SGPU1CLK", "GPU Clock", 1410},
+		{"sys", "SGPU1MEMCLK", "GPU Memory Clock", 7001}, {"sys", "SGPU1UTI", "GPU Utilization", 12}, {"sys", "SVMEMUSAGE", "GPU Memory Utilization", 9},
+		{"temp", "TMOBO", "Motherboard", 36}, {"temp", "TCPU", "CPU", 45}, {"temp", "TCPUPKG", "CPU Package", 51.5},
+		{"temp", "TCPUIA", "CPU IA Cores", 51}, {"temp", "TCPUGT", "CPU GT Cores", 40}, {"temp", "TCC-1-1", "CPU Core #1", 48},
+		{"temp", "TCC-1-2", "CPU Core #2", 50}, {"temp", "TCC-1-3", "CPU Core #3", 47}, {"temp", "TCC-1-4", "CPU Core #4", 52},
+		{"temp", "TCC-1-5", "CPU Core #5", 49}, {"temp", "TCC-1-6", "CPU Core #6", 46}, {"temp", "TCC-1-7", "CPU Core #7", 51},
+		{"temp", "TCC-1-8", "CPU Core #8", 48}, {"temp", "TPCHDIO", "PCH Diode", 44}, {"temp", "TGPU1", "GPU", 41},
+		{"temp", "TGPU1HOT", "GPU Hotspot", 50.4}, {"temp", "TGPU1MEM", "GPU Memory", 46}, {"temp", "THDD1", "Samsung SSD 970 EVO Plus 1TB", 39},
+		{"temp", "THDD2", "ST2000DM008-2FR102", 33}, {"temp", "TDIMM1", "DIMM2", 37.5}, {"temp", "TDIMM2", "DIMM4", 38},
+		{"fan", "FCPU", "CPU", 1118}, {"fan", "FCHA1", "Chassis #1", 812}, {"fan", "FCHA2", "Chassis #2", 795},
+		{"fan", "FPUMP", "Water Pump", 2410}, {"fan", "FGPU1", "GPU", 0}, {"duty", "DCPU", "CPU", 34},
+		{"duty", "DCHA1", "Chassis #1", 30}, {"duty", "DGPU1", "GPU", 0}, {"volt", "VCPU", "CPU Core", 1.148},
+		{"volt", "VCPUVID", "CPU VID", 1.244}, {"volt", "VP3V3", "+3.3 V", 3.344}, {"volt", "VP5V", "+5 V", 5.04},
+		{"volt", "VP12V", "+12 V", 12.096}, {"volt", "VDIMM", "DIMM", 1.356}, {"volt", "VPCH", "PCH Core", 1.05},
+		{"volt", "VVCCSA", "VCCSA", 1.184}, {"volt", "VVCCIO", "VCCIO", 1.088}, {"volt", "VGPU1", "GPU Core", 0.725},
+		{"curr", "CCPU", "CPU", 9.54}, {"curr", "CGPU1", "GPU", 12.32}, {"pwr", "PCPUPKG", "CPU Package", 28.61},
+		{"pwr", "PCPUIA", "CPU IA Cores", 20.97}, {"pwr", "PCPUGT", "CPU GT Cores", 0.02}, {"pwr", "PGPU1", "GPU", 24.7},
+		{"pwr", "PGPU1TDPP", "GPU TDP%", 11}
+	};
+	std::string payload = "<sys><id>SDATE</id><label>Date</label><value>17.10.2026</value></sys>"
+		"<sys><id>STIME</id><label>Time</label><value>12:" + std::to_string(10 + sampleIndex % 50) + ":00</value></sys>";
+	int itemIndex = 0;
+	for (const aidaItem& item : items)
+	{
+		//values drift between samples like real recording
+		double value = item.value + ((sampleIndex + itemIndex++) % 7) * 0.5;
+		std::string valueText = std::to_string(value);
+		valueText.erase(valueText.find_last_not_of('0') + 1);
+		if (valueText.back() == '.')
+		{
+			valueText.pop_back();
+		}
+		payload += std::string("<") + item.category + "><id>" + item.id + "</id><label>" + item.label +
+			std::string(labelPadding, '.') + "</label><value>" +
+			valueText + "</value></" + item.category + ">";
+	}
+	return payload;
+}
+
+//old AIDA64Temperatures parsing: block copy to string, <temp> elements and their fields by std::regex
+static void parseAIDA64ByRegex(const char* sensorsBuffer, std::map<std::string, double>& temperValues)
+{
+	auto getDataStrByRegex = [](const std::string& str, const std::regex& regExpr)->std::string
+	{
+		std::smatch regexMatch;
+		if (std::regex_search(str, regexMatch, regExpr))
+		{
+			return regexMatch[1];
+		}
+		return "";
+	};
+	std::string sensStr(sensorsBuffer);
+	std::regex regexTemp("<temp>(.*?)</temp>");
+	std::smatch regTempMatch;
+	std::string::const_iterator sensStrStart(sensStr.cbegin());
+	while (std::regex_search(sensStrStart, sensStr.cend(), regTempMatch, regexTemp))
+	{
+		temperValues[getDataStrByRegex(regTempMatch[1], std::regex("<label>(.*?)</label>"))] =
+			std::stod(getDataStrByRegex(regTempMatch[1], std::regex("<value>(.*?)</value>")));
+		sensStrStart = regTempMatch.suffix().first;
+	}
+}
+
+//single pass tokenizer (ParseAIDA64Sensors), same result
+static void parseAIDA64ByTokenizer(const char* sensorsBuffer, std::map<std::string, double>& temperValues)
+{
+	ParseAIDA64Sensors(std::string_view(sensorsBuffer), [&temperValues](const AIDA64SensorItem& item)
+	{
+		double value = 0.0;
+		if (item.category == "temp" && ParseAIDA64Value(item.value, value))
+		{
+			temperValues[std::string(item.label)] = value;
+		}
+	});
+}
+
+/* AIDA64 block parse cost: regex vs tokenizer on recorded-like payloads */
+template <typename parseFunction>
+static void benchAIDA64Parse(const char* parserName, parseFunction&& parse, const std::vector<std::string>& payloads, int roundsCount)
+{
+	std::map<std::string, double> temperValues{};
+	size_t itemsCount = 0;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	for (int round = 0; round < roundsCount; round++)
+	{
+		for (const std::string& payload : payloads)
+		{
+			temperValues.clear();
+			parse(payload.c_str(), temperValues);
+			itemsCount += temperValues.size();
+		}
+	}
+	double elapsedNsec = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+	size_t parsesCount = static_cast<size_t>(roundsCount) * payloads.size();
+	std::cout << "AIDA64 parse " << parserName <<
+		": " << static_cast<uint64_t>(elapsedNsec / parsesCount) << " ns/block" <<
+		", " << payloads.front().size() << " bytes, " << itemsCount / parsesCount << " temperatures" << std::endl;
+}
+
+static void benchAIDA64Parsers()
+{
+	std::vector<std::string> payloads;
+	for (int i = 0; i < 60; i++)
+	{
+		payloads.push_back(makeAIDA64Payload(i, 0));
+	}
+	//both parsers give same temperatures
+	for (const std::string& payload : payloads)
+	{
+		std::map<std::string, double> regexValues{}, tokenizerValues{};
+		parseAIDA64ByRegex(payload.c_str(), regexValues);
+		parseAIDA64ByTokenizer(payload.c_str(), tokenizerValues);
+		if (regexValues != tokenizerValues)
+		{
+			std::cout << "AIDA64 parse: regex and tokenizer results differ" << std::endl;
+			return;
+		}
+	}
+	benchAIDA64Parse("regex    ", parseAIDA64ByRegex, payloads, 20);
+	benchAIDA64Parse("tokenizer", parseAIDA64ByTokenizer, payloads, 2000);
+}
+
+/* AIDA64 reader poll cost: full parse every poll vs cached value spans re-read */
+/* producer writes new sample (value widths change) every poll, fullParsePeriod = 1 - full parse every poll */
+static void benchAIDA64Poll(int fullParsePeriod, size_t labelPadding, int pollsCount)
+{
+	std::vector<std::string> payloads;
+	for (int i = 0; i < 60; i++)
+	{
+		payloads.push_back(makeAIDA64Payload(i, labelPadding));
+	}
+	SharedMemoryView producerView;
+	if (!producerView.Create("AIDA64_SensorValues", payloads.front().size() + 4096))
+	{
+		std::cout << "Can't create AIDA64_SensorValues, error = " << producerView.LastError() << std::endl;
+		return;
+	}
+	char* shMem = static_cast<char*>(producerView.Data());
+
+	AIDA64Temperatures aidaTemper;
+	aidaTemper.SetFullParsePeriod(fullParsePeriod);
+	std::memcpy(shMem, payloads.front().c_str(), payloads.front().size() + 1);
+	aidaTemper.UpdateTemperatures();
+	aidaTemper.ResetReadStats();
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	int failedPolls = 0;
+	for (int i = 1; i <= pollsCount; i++)
+	{
+		const std::string& payload = payloads[i % payloads.size()];
+		std::memcpy(shMem, payload.c_str(), payload.size() + 1);
+		if (!aidaTemper.UpdateTemperatures())
+		{
+			failedPolls++;
+		}
+	}
+	double elapsedNsec = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+	//reader values are same as full parse of last sample
+	std::map<std::string, double> readerValues{}, expectedValues{};
+	aidaTemper.GetTemperatures(readerValues);
+	ParseAIDA64Sensors(std::string_view(payloads[pollsCount % payloads.size()]), [&expectedValues](const AIDA64SensorItem& item)
+	{
+		double value = 0.0;
+		if (ParseAIDA64Value(item.value, value))
+		{
+			expectedValues[std::string(item.id)] = value;
+		}
+	});
+	const AIDA64ReadStats& readStats = aidaTemper.GetReadStats();
+	std::cout << "AIDA64 poll " << (fullParsePeriod == 1 ? "full parse " : "value spans") <<
+		", " << payloads.front().size() << " bytes" <<
+		": " << static_cast<uint64_t>(elapsedNsec / pollsCount) << " ns/poll" <<
+		", incremental " << readStats.incrementalUpdates << "/" << readStats.pollsTotal <<
+		", full " << readStats.fullParses <<
+		", failed " << failedPolls <<
+		", values " << (readerValues == expectedValues ? "OK" : "FAIL") << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* reader latency: 10 ns buckets up to 100 us, exact max */
+struct readLatencyStats
+{
+	static constexpr int64_t BUCKET_NSEC = 10;
+	static constexpr size_t BUCKETS_COUNT = 10000;
+	std::vector<uint64_t> buckets = std::vector<uint64_t>(BUCKETS_COUNT + 1, 0);
+	uint64_t readsCount = 0;
+	int64_t maxNsec = 0;
+
+	void Add(std::chrono::steady_clock::duration latency)
+	{
+		int64_t latencyNsec = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+		buckets[std::min(static_cast<size_t>(latencyNsec / BUCKET_NSEC), BUCKETS_COUNT)]++;
+		readsCount++;
+		maxNsec = std::max(maxNsec, latencyNsec);
+	}
+	void Merge(const readLatencyStats& other)
+	{
+		for (size_t i = 0; i < buckets.size(); i++)
+		{
+			buckets[i] += other.buckets[i];
+		}
+		readsCount += other.readsCount;
+		maxNsec = std::max(maxNsec, other.maxNsec);
+	}
+	//upper bound of bucket with given part of reads (0.5 - p50), max for last bucket
+	int64_t Percentile(double part) const
+	{
+		uint64_t readsBelow = 0;
+		for (size_t i = 0; i < BUCKETS_COUNT; i++)
+		{
+			readsBelow += buckets[i];
+			if (static_cast<double>(readsBelow) >= part * static_cast<double>(readsCount))
+			{
+				return std::min(static_cast<int64_t>(i + 1) * BUCKET_NSEC, maxNsec);
+			}
+		}
+		return maxNsec;
+	}
+	std::string Format() const
+	{
+		return "read p50/p99/max " + std::to_string(Percentile(0.5)) + "/" + std::to_string(Percentile(0.99)) + "/" +
+			std::to_string(maxNsec) + " ns";
+	}
+};
+
+/* snapshot publication: 1 writer publishes, readers check every snapshot is whole (not torn) */
+/* snapshot g holds value g and timestamp g for all sensors */
+/* writerActive - writer publishes without pause, otherwise publishes once and waits (reader latency baseline) */
+static void benchSnapshotPublisher(int readersCount, int sensorsCount, std::chrono::milliseconds duration, bool writerActive)
+{
+	SensorTable sensorsTable;
+	for (int i = 0; i < sensorsCount; i++)
+	{
+		sensorsTable.Register("Sensor " + std::to_string(i));
+	}
+	SensorSnapshotPublisher snapshotPublisher;
+
+	std::atomic_bool stopFlag = false;
+	std::atomic<uint64_t> readsCount = 0, tornCount = 0, staleCount = 0;
+	std::vector<readLatencyStats> readersLatency(readersCount);
+	std::vector<std::thread> readerThreads;
+	for (int r = 0; r < readersCount; r++)
+	{
+		readerThreads.emplace_back([&, r]()
+		{
+			uint64_t threadReads = 0, threadTorn = 0, threadStale = 0;
+			uint64_t lastGeneration = 0;
+			while (!stopFlag.load(std::memory_order_relaxed))
+			{
+				std::chrono::steady_clock::time_point readStart = std::chrono::steady_clock::now();
+				SensorSnapshotRef snapshot = snapshotPublisher.GetCurrent();
+				if (!snapshot)
+				{
+					continue;
+				}
+				double generationValue = static_cast<double>(snapshot->Generation());
+				for (size_t i = 0; i < snapshot->Size(); i++)
+				{
+					if (snapshot->Value(static_cast<SensorHandle>(i)) != generationValue ||
+						snapshot->Timestamp(static_cast<SensorHandle>(i)) != static_cast<int64_t>(snapshot->Generation()))
+					{
+						threadTorn++;
+						break;
+					}
+				}
+				//current snapshot never goes back
+				if (snapshot->Generation() < lastGeneration)
+				{
+					threadStale++;
+				}
+				lastGeneration = snapshot->Generation();
+				threadReads++;
+				readersLatency[r].Add(std::chrono::steady_clock::now() - readStart);
+			}
+			readsCount += threadReads;
+			tornCount += threadTorn;
+			staleCount += threadStale;
+		});
+	}
+
+	uint64_t publishCount = 0;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	while (std::chrono::steady_clock::now() - startTime < duration)
+	{
+		publishCount++;
+		for (int i = 0; i < sensorsCount; i++)
+		{
+			sensorsTable.SetValue(static_cast<SensorHandle>(i), static_cast<double>(publishCount), static_cast<int64_t>(publishCount));
+		}
+		snapshotPublisher.Publish(sensorsTable);
+		if (!writerActive)
+		{
+			std::this_thread::sleep_until(startTime + duration);
+		}
+	}
+	stopFlag = true;
+	for (std::thread& readerThread : readerThreads)
+	{
+		readerThread.join();
+	}
+	double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	readLatencyStats readLatency;
+	for (const readLatencyStats& readerLatency : readersLatency)
+	{
+		readLatency.Merge(readerLatency);
+	}
+
+	std::cout << "snapshot publisher (RCU): " << readersCount << " readers, " << sensorsCount << " sensors" <<
+		": writer " << publishCount << " publishes (" << static_cast<uint64_t>(static_cast<double>(publishCount) / elapsedSec) << "/s)" <<
+		", readers " << static_cast<uint64_t>(static_cast<double>(readsCount) / elapsedSec) << " snapshots/s" <<
+		", " << readLatency.Format() <<
+		", torn " << tornCount << ", went back " << staleCount <<
+		", pool " << snapshotPublisher.PoolSize() << std::endl;
+}
+
+/* same load with locking publication: mutex guarded shared_ptr to new values copy */
+static void benchLockedPublisher(int readersCount, int sensorsCount, std::chrono::milliseconds duration, bool writerActive)
+{
+	std::mutex snapshotMutex;
+	std::shared_ptr<const std::vector<double>> currentSnapshot = nullptr;
+
+	std::atomic_bool stopFlag = false;
+	std::atomic<uint64_t> readsCount = 0, tornCount = 0;
+	std::vector<readLatencyStats> readersLatency(readersCount);
+	std::vector<std::thread> readerThreads;
+	for (int r = 0; r < readersCount; r++)
+	{
+		readerThreads.emplace_back([&, r]()
+		{
+			uint64_t threadReads = 0, threadTorn = 0;
+			while (!stopFlag.load(std::memory_order_relaxed))
+			{
+				std::chrono::steady_clock::time_point readStart = std::chrono::steady_clock::now();
+				std::shared_ptr<const std::vector<double>> snapshot = nullptr;
+				{
+					std::lock_guard<std::mutex> snapshotLock(snapshotMutex);
+					snapshot = currentSnapshot;
+				}
+				if (snapshot == nullptr)
+				{
+					continue;
+				}
+				for (double value : *snapshot)
+				{
+					if (value != snapshot->front())
+					{
+						threadTorn++;
+						break;
+					}
+				}
+				threadReads++;
+				readersLatency[r].Add(std::chrono::steady_clock::now() - readStart);
+			}
+			readsCount += threadReads;
+			tornCount += threadTorn;
+		});
+	}
+
+	uint64_t publishCount = 0;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	while (std::chrono::steady_clock::now() - startTime < duration)
+	{
+		publishCount++;
+		std::shared_ptr<const std::vector<double>> snapshot =
+			std::make_shared<const std::vector<double>>(sensorsCount, static_cast<double>(publishCount));
+		{
+			std::lock_guard<std::mutex> snapshotLock(snapshotMutex);
+			currentSnapshot = std::move(snapshot);
+		}
+		if (!writerActive)
+		{
+			std::this_thread::sleep_until(startTime + duration);
+		}
+	}
+	stopFlag = true;
+	for (std::thread& readerThread : readerThreads)
+	{
+		readerThread.join();
+	}
+	double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	readLatencyStats readLatency;
+	for (const readLatencyStats& readerLatency : readersLatency)
+	{
+		readLatency.Merge(readerLatency);
+	}
+
+	std::cout << "snapshot publisher (mutex): " << readersCount << " readers, " << sensorsCount << " sensors" <<
+		": writer " << publishCount << " publishes (" << static_cast<uint64_t>(static_cast<double>(publishCount) / elapsedSec) << "/s)" <<
+		", readers " << static_cast<uint64_t>(static_cast<double>(readsCount) / elapsedSec) << " snapshots/s" <<
+		", " << readLatency.Format() <<
+		", torn " << tornCount << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* compressed history blocks: size per sample, encode and decode speed */
+/* trace: 1 s period with +-3 ms jitter (msec timestamps), temperature random walk with 0.1 step */
+/* valueChangePercent - share of samples with changed value (steady sensor ~40, noisy sensor 100) */
+static void benchCompressedHistory(size_t samplesCount, size_t samplesPerBlock, int valueChangePercent)
+{
+	std::mt19937 traceRandom(15);
+	std::vector<int64_t> timestamps(samplesCount);
+	std::vector<double> values(samplesCount);
+	int64_t sampleTimestamp = 1792224000000LL;
+	int valueTenths = 450;
+	for (size_t i = 0; i < samplesCount; i++)
+	{
+		sampleTimestamp += 1000 + static_cast<int>(traceRandom() % 7) - 3;
+		if (static_cast<int>(traceRandom() % 100) < valueChangePercent)
+		{
+			valueTenths += traceRandom() % 2 ? 1 : -1;
+		}
+		valueTenths = std::clamp(valueTenths, 300, 900);
+		timestamps[i] = sampleTimestamp;
+		values[i] = valueTenths / 10.0;
+	}
+
+	//encode
+	std::vector<SensorCompressedBlock> blocks;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	SensorBlockEncoder blockEncoder;
+	for (size_t i = 0; i < samplesCount; i++)
+	{
+		blockEncoder.Append(timestamps[i], values[i]);
+		if (blockEncoder.Count() == samplesPerBlock)
+		{
+			blocks.push_back(blockEncoder.Seal());
+		}
+	}
+	if (blockEncoder.Count() > 0)
+	{
+		blocks.push_back(blockEncoder.Seal());
+	}
+	double encodeSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	//decode, then compare with source samples
+	std::vector<int64_t> decodedTimestamps;
+	std::vector<double> decodedValues;
+	decodedTimestamps.reserve(samplesCount);
+	decodedValues.reserve(samplesCount);
+	startTime = std::chrono::steady_clock::now();
+	for (const SensorCompressedBlock& block : blocks)
+	{
+		SensorBlockDecoder blockDecoder(block);
+		int64_t decodedTimestamp = 0;
+		double decodedValue = 0.0;
+		while (blockDecoder.Next(decodedTimestamp, decodedValue))
+		{
+			decodedTimestamps.push_back(decodedTimestamp);
+			decodedValues.push_back(decodedValue);
+		}
+	}
+	double decodeSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	size_t decodedCount = decodedValues.size();
+	bool samplesMatch = decodedTimestamps == timestamps &&
+		std::memcmp(decodedValues.data(), values.data(), samplesCount * sizeof(double)) == 0;
+
+	size_t compressedBytes = 0;
+	for (const SensorCompressedBlock& block : blocks)
+	{
+		compressedBytes += block.SizeBytes();
+	}
+	std::cout << "compressed history: " << samplesCount << " samples, " << samplesPerBlock << " per block, " <<
+		valueChangePercent << "% values changed" <<
+		": " << static_cast<double>(compressedBytes) / static_cast<double>(samplesCount) << " bytes/sample (raw 16)" <<
+		", encode " << static_cast<double>(samplesCount) / encodeSec / 1e6 << "M samples/s" <<
+		", decode " << static_cast<double>(decodedCount) / decodeSec / 1e6 << "M samples/s" <<
+		", decoded samples " << (decodedCount == samplesCount && samplesMatch ? "match" : "DIFFER") << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* quantile sketch: update cost, rank error of p50/p95/p99 against exact ranks, kept items */
+/* samples: normal temperature noise (50, sd 5) with +40 spikes every 1000 samples */
+static void benchQuantileSketch(int samplesCount, int sketchAccuracy)
+{
+	std::mt19937 sampleRandom(17);
+	std::normal_distribution<double> temperNoise(50.0, 5.0);
+	std::vector<double> samples(samplesCount);
+	for (int i = 0; i < samplesCount; i++)
+	{
+		samples[i] = temperNoise(sampleRandom) + (i % 1000 == 0 ? 40.0 : 0.0);
+	}
+
+	SensorQuantileSketch quantileSketch(sketchAccuracy);
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	for (double sample : samples)
+	{
+		quantileSketch.Update(sample);
+	}
+	double updateNsec = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+
+	//two halves merged - same accuracy expected (fleet-wide merge of windows)
+	SensorQuantileSketch firstHalf(sketchAccuracy), secondHalf(sketchAccuracy);
+	for (int i = 0; i < samplesCount; i++)
+	{
+		(i < samplesCount / 2 ? firstHalf : secondHalf).Update(samples[i]);
+	}
+	firstHalf.Merge(secondHalf);
+
+	std::sort(samples.begin(), samples.end());
+	//rank error: |exact rank of sketch answer / count - quantile|
+	auto rankError = [&samples](const SensorQuantileSketch& sketch, double quantile)
+	{
+		double answer = sketch.Quantile(quantile);
+		size_t exactRank = static_cast<size_t>(std::lower_bound(samples.begin(), samples.end(), answer) - samples.begin());
+		return std::abs(static_cast<double>(exactRank) / static_cast<double>(samples.size()) - quantile);
+	};
+	std::cout << "quantile sketch: " << samplesCount << " samples, k " << sketchAccuracy <<
+		": " << updateNsec / samplesCount << " ns/update" <<
+		", items " << quantileSketch.ItemsCount() <<
+		", rank error p50 " << rankError(quantileSketch, 0.5) * 100.0 << "%" <<
+		" p95 " << rankError(quantileSketch, 0.95) * 100.0 << "%" <<
+		" p99 " << rankError(quantileSketch, 0.99) * 100.0 << "%" <<
+		", merged p99 " << rankError(firstHalf, 0.99) * 100.0 << "%" <<
+		", serialized " << quantileSketch.Serialize().size() << " bytes" << std::endl;
+}
+//*********************************************************************************************************//
+
+//*********************************************************************************************************//
+/* deadband check: sensor at zero (stopped fan) with relative threshold - repeated zeros are suppressed */
+static void checkDeadbandZeroValue()
+{
+	SensorDeadband deadband({ .absThreshold = 0.0, .relThreshold = 0.05, .maxSilence = 0 });
+	int publishedCount = 0;
+	int64_t sampleTimestamp = 0;
+	//first zero is published, next 99 zeros are not
+	for (int i = 0; i < 100; i++)
+	{
+		publishedCount += deadband.ShouldPublish(0, sampleTimestamp += 1000, 0.0) ? 1 : 0;
+	}
+	//fan started - published, then change < 5% - not published
+	publishedCount += deadband.ShouldPublish(0, sampleTimestamp += 1000, 1200.0) ? 1 : 0;
+	publishedCount += deadband.ShouldPublish(0, sampleTimestamp += 1000, 1230.0) ? 1 : 0;
+	std::cout << "deadband zero value: published " << publishedCount << " of 102 samples (expected 2) - " <<
+		(publishedCount == 2 ? "OK" : "FAIL") << std::endl;
+}
+//*********************************************************************************************************//
+
+int main(int argc, char* argv[])
+{
+	for (int changedEvery : { 1, 4 })
+	{
+		benchGPUZAttach(GPUZAttachMode::GPUZ_ATTACH_PER_POLL, 20000, changedEvery);
+		benchGPUZAttach(GPUZAttachMode::GPUZ_ATTACH_PERSISTENT, 20000, changedEvery);
+	}
+
+	benchAIDA64Parsers();
+	//same values count, block size x1 and ~x8
+	for (size_t labelPadding : { 0, 400 })
+	{
+		benchAIDA64Poll(1, labelPadding, 20000);
+		benchAIDA64Poll(60, labelPadding, 20000);
+	}
+	//4 readers / 1 writer: reader latency with idle writer and with writer publishing without pause
+	for (bool writerActive : { false, true })
+	{
+		benchSnapshotPublisher(4, 64, std::chrono::milliseconds(2000), writerActive);
+		benchLockedPublisher(4, 64, std::chrono::milliseconds(2000), writerActive);
+	}
+	//blocks of 1 hour (2 sec period, as in PCSystemTemperatures) and 1 day
+	for (int valueChangePercent : { 40, 100 })
+	{
+		benchCompressedHistory(10000000, 1800, valueChangePercent);
+		benchCompressedHistory(10000000, 43200, valueChangePercent);
+	}
+	//1 day of 2 sec samples, 1M samples
+	for (int samplesCount : { 43200, 1000000 })
+	{
+		benchQuantileSketch(samplesCount, 200);
+	}
+
+	checkDeadbandZeroValue();
+
+	system("pause");
+
+	return 0;
+}